@@ -0,0 +1,143 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Minimal benchmark harness shared by the bench/ programs.
+//
+// A benchmark times its work in batches with Sampler::time(); each batch
+// contributes one ns/op sample, so percentiles describe batch-to-batch
+// variation without per-operation timer overhead. Results print as a table
+// and serialise to JSON for regression tracking.
+
+struct BenchmarkResult {
+    std::string name;
+    std::string variant;
+    long long size;
+    long long ops;
+    double total_ns;
+    std::vector<double> samples;  // ns/op per batch, sorted
+
+    double percentile(double p) const {
+        if (samples.empty()) return 0.0;
+        // Nearest rank
+        size_t rank = static_cast<size_t>(p / 100.0 * (samples.size() - 1) + 0.5);
+        return samples[std::min(rank, samples.size() - 1)];
+    }
+    double mean() const { return ops > 0 ? total_ns / ops : 0.0; }
+    double opsPerSecond() const { return total_ns > 0 ? ops * 1e9 / total_ns : 0.0; }
+};
+
+class Sampler {
+private:
+    std::vector<double> samples;
+    long long ops = 0;
+    double total_ns = 0.0;
+
+public:
+    // Run fn() once as a batch of batch_ops operations
+    template <typename Fn>
+    void time(long long batch_ops, Fn fn) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        samples.push_back(ns / batch_ops);
+        ops += batch_ops;
+        total_ns += ns;
+    }
+
+    BenchmarkResult result(const std::string& name, const std::string& variant, long long size) const {
+        BenchmarkResult r{name, variant, size, ops, total_ns, samples};
+        std::sort(r.samples.begin(), r.samples.end());
+        return r;
+    }
+};
+
+class BenchmarkReport {
+private:
+    std::vector<BenchmarkResult> results;
+
+    static std::string escape(const std::string& text) {
+        std::string out;
+        for (char c : text) {
+            if (c == '"' || c == '\\') out += '\\';
+            out += c;
+        }
+        return out;
+    }
+
+public:
+    static void printHeader() {
+        std::cout << std::left << std::setw(22) << "Benchmark"
+                  << std::setw(14) << "Variant"
+                  << std::right << std::setw(10) << "Size"
+                  << std::setw(12) << "ns/op"
+                  << std::setw(12) << "p50"
+                  << std::setw(12) << "p99"
+                  << std::setw(14) << "ops/s" << std::endl;
+        std::cout << std::string(96, '-') << std::endl;
+    }
+
+    void add(const BenchmarkResult& result) {
+        results.push_back(result);
+        std::cout << std::left << std::setw(22) << result.name
+                  << std::setw(14) << result.variant
+                  << std::right << std::setw(10) << result.size
+                  << std::fixed << std::setprecision(1)
+                  << std::setw(12) << result.mean()
+                  << std::setw(12) << result.percentile(50)
+                  << std::setw(12) << result.percentile(99)
+                  << std::setw(14) << std::setprecision(0) << result.opsPerSecond()
+                  << std::endl;
+    }
+
+    bool writeJson(const std::string& path) const {
+        std::ofstream out(path);
+        if (!out) {
+            return false;
+        }
+
+        char date[32];
+        std::time_t now = std::time(nullptr);
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+        out << std::fixed << std::setprecision(2);
+        out << "{\n";
+        out << "  \"schema\": 1,\n";
+        out << "  \"timestamp\": \"" << date << "\",\n";
+#ifdef __VERSION__
+        out << "  \"compiler\": \"" << escape(__VERSION__) << "\",\n";
+#endif
+        out << "  \"hardware_threads\": " << std::thread::hardware_concurrency() << ",\n";
+        out << "  \"results\": [\n";
+        for (size_t i = 0; i < results.size(); i++) {
+            const BenchmarkResult& r = results[i];
+            out << "    {\"name\": \"" << escape(r.name) << "\", "
+                << "\"variant\": \"" << escape(r.variant) << "\", "
+                << "\"size\": " << r.size << ", "
+                << "\"ops\": " << r.ops << ", "
+                << "\"samples\": " << r.samples.size() << ", "
+                << "\"ns_per_op\": {\"mean\": " << r.mean()
+                << ", \"min\": " << r.percentile(0)
+                << ", \"p50\": " << r.percentile(50)
+                << ", \"p90\": " << r.percentile(90)
+                << ", \"p99\": " << r.percentile(99)
+                << ", \"max\": " << r.percentile(100) << "}, "
+                << "\"ops_per_sec\": " << r.opsPerSecond() << "}"
+                << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        out << "  ]\n";
+        out << "}\n";
+        return static_cast<bool>(out);
+    }
+};
+
+#endif // BENCHMARK_H
@@ -0,0 +1,162 @@
+// Eager aging: one tick of recompute + heapify, 10^5 to 10^7 queued
+// processes, per piecewise-linear policy.
+//
+//  loop:    updateAllPriorities() + rebuildHeap(), one Process at a time
+//           (the path before the bulk kernel)
+//  scalar, avx2, avx512: applyAging() with that recompute kernel, which
+//           skips the heapify when no key moved
+//
+// ns per queued process per tick, lower is better. The aging factor is set
+// so the largest boost over the run stays below the base priorities, i.e.
+// every key moves on every tick (the worst case for the kernels). A last
+// table times the recompute alone: updateEffectivePriority() through
+// pointers in heap-like (scattered) order vs the kernels on arrays.
+
+#include "AgingKernel.h"
+#include "PriorityQueue.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+const long long WORK_PER_SIZE = 20000000;   // Entries recomputed per measurement
+
+std::vector<Process> makeProcesses(long long count) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<> priority_dist(1, 10);
+    std::vector<Process> processes;
+    processes.reserve(count);
+    for (long long i = 0; i < count; i++) {
+        processes.emplace_back(static_cast<int>(i), priority_dist(gen), i, 1);
+    }
+    return processes;
+}
+
+double elapsedNs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+// ns per entry per tick; kernel Auto = the per-process loop
+template <typename Policy>
+double measure(std::vector<Process>& processes, AgingKernel kernel, bool loop) {
+    long long n = static_cast<long long>(processes.size());
+    long long ticks = std::max(5LL, WORK_PER_SIZE / n);
+    BasicPriorityQueue<Policy> queue(0.5 / n, AgingMode::Eager);
+    setAgingKernel(kernel);
+
+    long long now = n;
+    queue.setCurrentTime(now);
+    for (auto& process : processes) {
+        queue.insert(&process);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (long long i = 0; i < ticks; i++) {
+        now++;
+        if (loop) {
+            queue.updateAllPriorities(now);
+            queue.rebuildHeap();
+        } else {
+            queue.applyAging(now);
+        }
+    }
+    double ns = elapsedNs(start) / (static_cast<double>(ticks) * n);
+
+    while (!queue.isEmpty()) {
+        queue.extractMin();
+    }
+    return ns;
+}
+
+// Recompute only, ns per entry; kernel Auto = the per-process loop
+double measureRecompute(long long n, AgingKernel kernel, bool loop) {
+    std::vector<Process> processes = makeProcesses(n);
+    std::vector<Process*> order;
+    std::vector<double> origin, base, effective(n, 0.0);
+    for (auto& process : processes) {
+        order.push_back(&process);
+        origin.push_back(static_cast<double>(process.getArrivalTime()));
+        base.push_back(process.getBasePriority());
+    }
+    std::shuffle(order.begin(), order.end(), std::mt19937(7));
+    setAgingKernel(kernel);
+
+    double factor = 0.5 / n;
+    long long ticks = std::max(5LL, WORK_PER_SIZE / n);
+    long long now = n;
+    auto start = std::chrono::steady_clock::now();
+    for (long long i = 0; i < ticks; i++) {
+        now++;
+        if (loop) {
+            for (Process* process : order) {
+                process->updateEffectivePriority(now, factor);
+            }
+        } else {
+            recomputeEffective(origin.data(), base.data(), effective.data(), n, now,
+                               factor, AgingShape{LinearAging::STEP, LinearAging::CAP});
+        }
+    }
+    return elapsedNs(start) / (static_cast<double>(ticks) * n);
+}
+
+template <typename Policy>
+void run(const char* name) {
+    const AgingKernel kernels[] = {AgingKernel::Scalar, AgingKernel::Avx2, AgingKernel::Avx512};
+
+    std::cout << std::endl << name << " aging (ns per entry per tick)" << std::endl;
+    std::cout << std::left << std::setw(12) << "Queued" << std::setw(10) << "Loop"
+              << std::setw(10) << "Scalar" << std::setw(10) << "AVX2" << "AVX-512" << std::endl;
+    std::cout << std::string(52, '-') << std::endl;
+
+    for (long long n = 100000; n <= 10000000; n *= 10) {
+        std::vector<Process> processes = makeProcesses(n);
+        std::cout << std::left << std::setw(12) << n << std::fixed << std::setprecision(2)
+                  << std::setw(10) << measure<Policy>(processes, AgingKernel::Auto, true);
+        for (AgingKernel kernel : kernels) {
+            double ns = measure<Policy>(processes, kernel, false);
+            std::cout << std::setw(10);
+            if (activeAgingKernel() == kernel) {
+                std::cout << ns;
+            } else {
+                std::cout << "n/a";
+            }
+        }
+        std::cout << std::endl;
+    }
+    setAgingKernel(AgingKernel::Auto);
+}
+
+}
+
+int main() {
+    std::cout << "Eager aging recompute + heapify, widest kernel here: "
+              << agingKernelName(activeAgingKernel()) << std::endl;
+    run<LinearAging>("Linear");
+    run<StepAging<>>("Step (every 10)");
+    run<CappedAging<>>("Capped (5 levels)");
+
+    const AgingKernel kernels[] = {AgingKernel::Scalar, AgingKernel::Avx2, AgingKernel::Avx512};
+    std::cout << std::endl << "Linear recompute only, no heap (ns per entry per tick)" << std::endl;
+    std::cout << std::left << std::setw(12) << "Queued" << std::setw(10) << "Loop"
+              << std::setw(10) << "Scalar" << std::setw(10) << "AVX2" << "AVX-512" << std::endl;
+    std::cout << std::string(52, '-') << std::endl;
+    for (long long n = 100000; n <= 10000000; n *= 10) {
+        std::cout << std::left << std::setw(12) << n << std::fixed << std::setprecision(2)
+                  << std::setw(10) << measureRecompute(n, AgingKernel::Auto, true);
+        for (AgingKernel kernel : kernels) {
+            double ns = measureRecompute(n, kernel, false);
+            std::cout << std::setw(10);
+            if (activeAgingKernel() == kernel) {
+                std::cout << ns;
+            } else {
+                std::cout << "n/a";
+            }
+        }
+        std::cout << std::endl;
+    }
+    return 0;
+}
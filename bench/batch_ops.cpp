@@ -0,0 +1,156 @@
+// Batch vs one-at-a-time queue operations (heap backend, lazy aging).
+//
+// With n processes queued, a batch of b arrives and b processes are then
+// taken, over and over, so the queue stays at n:
+//  insert:  b x insert()      vs insertBatch()
+//  extract: b x extractMin()  vs extractTopK(b)
+// Batches arrive at the current time, like a burst of arrivals on one tick,
+// in no particular key order (the taken processes are shuffled before they
+// come back).
+// A second table grows an empty queue to n in batches of b with nothing
+// taken, like a scheduler admitting each tick's arrivals while the backlog
+// builds up.
+// ns per process moved, lower is better.
+
+#include "PriorityQueue.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+const double AGING_FACTOR = 0.1;
+const long long WORK_PER_POINT = 2000000;   // Processes moved per measurement
+
+double elapsedNs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+struct Result {
+    double insert_ns;
+    double extract_ns;
+};
+
+Result measure(long long n, long long batch, bool batched) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<> priority_dist(1, 10);
+    std::vector<Process> processes;
+    processes.reserve(n + batch);
+    for (long long i = 0; i < n + batch; i++) {
+        processes.emplace_back(static_cast<int>(i), priority_dist(gen), std::min(i, n), 1);
+    }
+
+    PriorityQueue queue(AGING_FACTOR);
+    queue.setCurrentTime(n);
+    for (long long i = 0; i < n; i++) {
+        queue.insert(&processes[i]);
+    }
+    std::vector<Process*> pending;
+    for (long long i = n; i < n + batch; i++) {
+        pending.push_back(&processes[i]);
+    }
+
+    long long rounds = std::max(1LL, WORK_PER_POINT / batch);
+    double insert_ns = 0.0;
+    double extract_ns = 0.0;
+    std::vector<Process*> taken;
+    for (long long round = 0; round < rounds; round++) {
+        auto start = std::chrono::steady_clock::now();
+        if (batched) {
+            queue.insertBatch(pending);
+        } else {
+            for (Process* process : pending) {
+                queue.insert(process);
+            }
+        }
+        insert_ns += elapsedNs(start);
+
+        taken.clear();
+        start = std::chrono::steady_clock::now();
+        if (batched) {
+            queue.extractTopK(static_cast<size_t>(batch), taken);
+        } else {
+            for (long long i = 0; i < batch; i++) {
+                taken.push_back(queue.extractMin());
+            }
+        }
+        extract_ns += elapsedNs(start);
+        pending.swap(taken);
+        std::shuffle(pending.begin(), pending.end(), gen);
+    }
+    double moved = static_cast<double>(rounds) * batch;
+    return {insert_ns / moved, extract_ns / moved};
+}
+
+// ns per process inserted while the queue grows from 0 to n
+double measureGrowth(long long n, long long batch, bool batched) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<> priority_dist(1, 10);
+    std::vector<Process> processes;
+    processes.reserve(n);
+    for (long long i = 0; i < n; i++) {
+        processes.emplace_back(static_cast<int>(i), priority_dist(gen), i / batch, 1);
+    }
+    std::vector<Process*> pending;
+
+    PriorityQueue queue(AGING_FACTOR);
+    auto start = std::chrono::steady_clock::now();
+    for (long long first = 0; first < n; first += batch) {
+        long long last = std::min(n, first + batch);
+        queue.setCurrentTime(first / batch);
+        if (batched) {
+            pending.clear();
+            for (long long i = first; i < last; i++) {
+                pending.push_back(&processes[i]);
+            }
+            queue.insertBatch(pending);
+        } else {
+            for (long long i = first; i < last; i++) {
+                queue.insert(&processes[i]);
+            }
+        }
+    }
+    return elapsedNs(start) / n;
+}
+
+}
+
+int main() {
+    std::cout << "Batch queue operations (ns per process, lower is better)" << std::endl;
+    std::cout << std::left << std::setw(10) << "Queued" << std::setw(10) << "Batch"
+              << std::setw(13) << "insert x b" << std::setw(13) << "insertBatch"
+              << std::setw(16) << "extractMin x b" << "extractTopK" << std::endl;
+    std::cout << std::string(74, '-') << std::endl;
+
+    for (long long n = 1000; n <= 1000000; n *= 10) {
+        for (long long batch : {16LL, n / 100, n / 10, n / 2, n}) {
+            if (batch < 16) {
+                continue;
+            }
+            Result loop = measure(n, batch, false);
+            Result bulk = measure(n, batch, true);
+            std::cout << std::left << std::setw(10) << n << std::setw(10) << batch
+                      << std::fixed << std::setprecision(1)
+                      << std::setw(13) << loop.insert_ns << std::setw(13) << bulk.insert_ns
+                      << std::setw(16) << loop.extract_ns << bulk.extract_ns << std::endl;
+        }
+    }
+
+    std::cout << std::endl << "Growing queue (ns per process inserted)" << std::endl;
+    std::cout << std::left << std::setw(10) << "Final" << std::setw(10) << "Batch"
+              << std::setw(13) << "insert x b" << "insertBatch" << std::endl;
+    std::cout << std::string(44, '-') << std::endl;
+    for (long long n = 10000; n <= 1000000; n *= 10) {
+        for (long long batch : {4LL, 64LL, 1024LL}) {
+            double loop = measureGrowth(n, batch, false);
+            double bulk = measureGrowth(n, batch, true);
+            std::cout << std::left << std::setw(10) << n << std::setw(10) << batch
+                      << std::fixed << std::setprecision(1)
+                      << std::setw(13) << loop << bulk << std::endl;
+        }
+    }
+    return 0;
+}
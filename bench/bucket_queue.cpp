@@ -0,0 +1,94 @@
+// Heap vs bucket backend of PriorityQueue, from 10^3 to 10^7 queued
+// processes (base priorities 1-10, lazy aging).
+//
+//  fill+drain: insert n processes in arrival order, then extract them all
+//  hold:       with n queued, extract one and insert a new arrival, n times
+//              (at most 10^6), the steady state of a loaded scheduler
+
+#include "PriorityQueue.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+const double AGING_FACTOR = 0.1;
+const long long MAX_HOLD_OPS = 1000000;
+
+std::vector<Process> makeProcesses(long long count) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<> priority_dist(1, 10);
+    std::vector<Process> processes;
+    processes.reserve(count);
+    for (long long i = 0; i < count; i++) {
+        // Roughly one arrival per time unit, in order
+        processes.emplace_back(static_cast<int>(i), priority_dist(gen), i, 1);
+    }
+    return processes;
+}
+
+double elapsedNs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+// ns per operation (each insert and each extract counts as one)
+void measure(QueueBackend backend, std::vector<Process>& processes, long long n,
+             double& fill_drain_ns, double& hold_ns) {
+    PriorityQueue queue(AGING_FACTOR, AgingMode::Lazy, backend);
+
+    auto start = std::chrono::steady_clock::now();
+    for (long long i = 0; i < n; i++) {
+        queue.insert(&processes[i]);
+    }
+    long long now = n;
+    queue.applyAging(now);
+    while (!queue.isEmpty()) {
+        queue.extractMin();
+    }
+    fill_drain_ns = elapsedNs(start) / (2.0 * n);
+
+    for (long long i = 0; i < n; i++) {
+        queue.insert(&processes[i]);
+    }
+    long long ops = std::min(n, MAX_HOLD_OPS);
+    start = std::chrono::steady_clock::now();
+    for (long long i = 0; i < ops; i++) {
+        queue.applyAging(++now);
+        queue.extractMin();
+        queue.insert(&processes[n + i]);
+    }
+    hold_ns = elapsedNs(start) / (2.0 * ops);
+}
+
+}
+
+int main() {
+    std::cout << "PriorityQueue backends (ns/op, lower is better)" << std::endl;
+    std::cout << std::left << std::setw(12) << "Queued"
+              << std::setw(16) << "Heap fill+drain"
+              << std::setw(18) << "Bucket fill+drain"
+              << std::setw(12) << "Heap hold"
+              << "Bucket hold" << std::endl;
+    std::cout << std::string(70, '-') << std::endl;
+
+    for (long long n = 1000; n <= 10000000; n *= 10) {
+        std::vector<Process> processes = makeProcesses(n + std::min(n, MAX_HOLD_OPS));
+        double heap_fill, heap_hold, bucket_fill, bucket_hold;
+        measure(QueueBackend::Heap, processes, n, heap_fill, heap_hold);
+
+        // Fresh records: the first run left execution state behind
+        processes = makeProcesses(n + std::min(n, MAX_HOLD_OPS));
+        measure(QueueBackend::Bucket, processes, n, bucket_fill, bucket_hold);
+
+        std::cout << std::left << std::setw(12) << n
+                  << std::setw(16) << std::fixed << std::setprecision(1) << heap_fill
+                  << std::setw(18) << bucket_fill
+                  << std::setw(12) << heap_hold
+                  << bucket_hold << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,152 @@
+// Throughput of the relaxed MultiQueue against a single mutex around
+// PriorityQueue, from 1 to 64 threads, plus the measured rank error of the
+// MultiQueue's extraction order.
+//
+// Each thread repeatedly extracts a process and reinserts it, keeping the
+// queue at a steady size.
+
+#include "ConcurrentPriorityQueue.h"
+#include "PriorityQueue.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const int QUEUE_SIZE = 1 << 16;
+const int OPS_PER_THREAD = 200000;
+const double AGING_FACTOR = 0.1;
+
+std::vector<Process> makeProcesses(int count) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<> priority_dist(1, 10);
+    std::uniform_int_distribution<> arrival_dist(0, 1000000);
+    std::vector<Process> processes;
+    processes.reserve(count);
+    for (int i = 0; i < count; i++) {
+        processes.emplace_back(i, priority_dist(gen), arrival_dist(gen), 1);
+    }
+    return processes;
+}
+
+// The single-lock alternative
+class LockedQueue {
+private:
+    std::mutex lock;
+    PriorityQueue queue;
+
+public:
+    explicit LockedQueue(double aging_factor) : queue(aging_factor) {}
+
+    void insert(Process* process) {
+        std::lock_guard<std::mutex> guard(lock);
+        queue.insert(process);
+    }
+
+    Process* extractMin() {
+        std::lock_guard<std::mutex> guard(lock);
+        return queue.extractMin();
+    }
+};
+
+template <typename Queue>
+double measureThroughput(Queue& queue, std::vector<Process>& processes, int threads) {
+    for (auto& process : processes) {
+        queue.insert(&process);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&queue]() {
+            for (int i = 0; i < OPS_PER_THREAD; i++) {
+                Process* process = queue.extractMin();
+                if (process) {
+                    queue.insert(process);
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Two operations (extract + insert) per iteration
+    return 2.0 * OPS_PER_THREAD * threads / seconds / 1e6;
+}
+
+// Mean and max rank of extracted processes among everything queued (the
+// process is reinserted after each extraction), for a
+// MultiQueue sized for the given thread count (measured single-threaded so
+// the reference order is exact)
+void measureRankError(int threads, double& mean_rank, long long& max_rank) {
+    const int size = 4096;
+    const int extractions = 20000;
+    std::vector<Process> processes = makeProcesses(size);
+    ConcurrentPriorityQueue queue(threads, 2, AGING_FACTOR);
+    for (auto& process : processes) {
+        queue.insert(&process);
+    }
+
+    auto key = [](const Process* p) {
+        return p->getBasePriority() + p->getArrivalTime() * AGING_FACTOR;
+    };
+
+    double rank_sum = 0;
+    max_rank = 0;
+    for (int i = 0; i < extractions; i++) {
+        Process* process = queue.extractMin();
+        long long rank = 0;
+        for (int j = 0; j < size; j++) {
+            if (key(&processes[j]) < key(process)) {
+                rank++;
+            }
+        }
+        rank_sum += rank;
+        max_rank = std::max(max_rank, rank);
+        queue.insert(process);
+    }
+    mean_rank = rank_sum / extractions;
+}
+
+}
+
+int main() {
+    std::vector<Process> processes = makeProcesses(QUEUE_SIZE);
+    const int thread_counts[] = {1, 2, 4, 8, 16, 32, 64};
+
+    std::cout << "Concurrent queue throughput (" << QUEUE_SIZE << " queued, "
+              << OPS_PER_THREAD << " extract+insert per thread, "
+              << std::thread::hardware_concurrency() << " hardware threads)" << std::endl;
+    std::cout << std::left << std::setw(10) << "Threads"
+              << std::setw(18) << "Locked (Mops/s)"
+              << std::setw(21) << "MultiQueue (Mops/s)"
+              << std::setw(12) << "Mean rank"
+              << "Max rank" << std::endl;
+    std::cout << std::string(73, '-') << std::endl;
+
+    for (int threads : thread_counts) {
+        LockedQueue locked(AGING_FACTOR);
+        double locked_mops = measureThroughput(locked, processes, threads);
+
+        ConcurrentPriorityQueue multi(threads, 2, AGING_FACTOR);
+        double multi_mops = measureThroughput(multi, processes, threads);
+
+        double mean_rank;
+        long long max_rank;
+        measureRankError(threads, mean_rank, max_rank);
+
+        std::cout << std::left << std::setw(10) << threads
+                  << std::setw(18) << std::fixed << std::setprecision(2) << locked_mops
+                  << std::setw(21) << multi_mops
+                  << std::setw(12) << mean_rank
+                  << max_rank << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,74 @@
+// Where a scheduling run's queue time goes: heap comparisons, swaps and
+// sift levels per insert / extractMin / rebuildHeap, and the share of the
+// run spent in applyAging. Built with PQ_INSTRUMENT=1 (see the Makefile),
+// so absolute times include the counting overhead.
+//
+// Poisson arrivals at 95% load keep a backlog that grows with the workload;
+// eager aging rebuilds the heap on every dispatch, so it stops at 10^5.
+
+#include "Scheduler.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+
+const long long MAX_EAGER_JOBS = 100000;
+
+void row(const char* name, const QueueOpStats::Op& op) {
+    double calls = op.calls ? static_cast<double>(op.calls) : 1.0;
+    std::cout << "  " << std::left << std::setw(13) << name << std::right
+              << std::setw(12) << op.calls
+              << std::setw(13) << op.comparisons / calls
+              << std::setw(10) << op.swaps / calls
+              << std::setw(10) << op.levels / calls << std::endl;
+}
+
+void measure(AgingMode mode, long long jobs) {
+    WorkloadSpec spec;
+    spec.seed = 42;
+    spec.count = jobs;
+    spec.arrivals = ArrivalPattern::Poisson;
+    spec.mean_interarrival = 5.8;   // Mean burst 5.5
+    WorkloadGenerator generator(spec, 1);
+
+    Scheduler scheduler(0.01, false);
+    scheduler.setAgingMode(mode);
+    scheduler.setWorkloadSource(&generator);
+
+    auto start = std::chrono::steady_clock::now();
+    scheduler.run();
+    double run_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    const QueueOpStats& ops = scheduler.getQueueOpStats();
+    std::cout << (mode == AgingMode::Lazy ? "lazy" : "eager") << ", " << jobs << " jobs: "
+              << std::fixed << std::setprecision(1) << run_ns / 1e6 << " ms, applyAging "
+              << 100.0 * ops.aging_ns / run_ns << "% ("
+              << ops.aging_calls << " calls)" << std::endl;
+    std::cout << "  " << std::left << std::setw(13) << "Operation" << std::right
+              << std::setw(12) << "Calls" << std::setw(13) << "Comparisons"
+              << std::setw(10) << "Swaps" << std::setw(10) << "Levels" << std::endl;
+    std::cout << std::setprecision(2);
+    row("insert", ops.insert);
+    row("extractMin", ops.extract_min);
+    row("insertBatch", ops.insert_batch);
+    row("extractTopK", ops.extract_top_k);
+    row("rebuildHeap", ops.rebuild);
+    std::cout << std::defaultfloat << std::setprecision(6) << std::endl;
+}
+
+}
+
+int main() {
+    static_assert(PriorityQueue::INSTRUMENTED, "build with -DPQ_INSTRUMENT=1");
+
+    std::cout << "Heap work per queue operation (arity " << PriorityQueue::HEAP_ARITY << ")"
+              << std::endl << std::endl;
+    for (long long jobs = 1000; jobs <= 1000000; jobs *= 10) {
+        measure(AgingMode::Lazy, jobs);
+        if (jobs <= MAX_EAGER_JOBS) {
+            measure(AgingMode::Eager, jobs);
+        }
+    }
+    return 0;
+}
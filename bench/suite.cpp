@@ -0,0 +1,238 @@
+// Microbenchmark suite for the queue and the scheduler (make bench).
+//
+//   bench_suite.exe [--min-size N] [--max-size N] [--json FILE]
+//
+// Sizes run in powers of ten from --min-size (default 100) to --max-size
+// (default 10^7). Workloads come from a fixed seed, so runs are comparable
+// across builds; results go to the console and, with --json, to a file.
+
+#include "Benchmark.h"
+#include "PriorityQueue.h"
+#include "Scheduler.h"
+#include "WorkloadGenerator.h"
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+
+const double AGING_FACTOR = 0.1;
+const long long TARGET_OPS = 1000000;  // Small sizes repeat until about this many ops
+
+WorkloadSpec benchWorkload(long long n) {
+    WorkloadSpec spec;
+    spec.seed = 42;
+    spec.count = n;
+    spec.mean_interarrival = 1.0;
+    return spec;
+}
+
+// n Poisson arrivals, about one per time unit, priorities and bursts 1-10.
+// The generator is platform-independent, so every build sees the same data.
+std::vector<Process> makeProcesses(long long n) {
+    WorkloadGenerator generator(benchWorkload(n));
+    std::vector<Process> processes;
+    processes.reserve(n);
+    TraceRecord record;
+    while (generator.next(record)) {
+        processes.emplace_back(record.id, record.priority, record.arrival, record.burst);
+    }
+    return processes;
+}
+
+// Operations per timed batch: whole fills for small sizes, 64 batches for large
+long long batchSize(long long n) {
+    return std::max(std::min(n, 256LL), n / 64);
+}
+
+long long repetitions(long long n) {
+    return std::max(1LL, TARGET_OPS / n);
+}
+
+// Backend, suffixed with the policy unless it is the default linear one
+template <typename Policy>
+std::string variantName(QueueBackend backend) {
+    std::string name = backend == QueueBackend::Heap ? "heap" : "bucket";
+    return Policy::FIXED_POINT ? name + "-" + Policy::NAME : name;
+}
+
+template <typename Policy = LinearAging>
+void benchInsert(BenchmarkReport& report, const std::vector<Process>& pristine,
+                 QueueBackend backend) {
+    long long n = pristine.size();
+    Sampler sampler;
+    for (long long rep = 0; rep < repetitions(n); rep++) {
+        std::vector<Process> processes = pristine;
+        BasicPriorityQueue<Policy> queue(AGING_FACTOR, AgingMode::Lazy, backend);
+        for (long long begin = 0; begin < n; begin += batchSize(n)) {
+            long long end = std::min(n, begin + batchSize(n));
+            sampler.time(end - begin, [&]() {
+                for (long long i = begin; i < end; i++) {
+                    queue.insert(&processes[i]);
+                }
+            });
+        }
+    }
+    report.add(sampler.result("pq_insert", variantName<Policy>(backend), n));
+}
+
+template <typename Policy = LinearAging>
+void benchExtract(BenchmarkReport& report, const std::vector<Process>& pristine,
+                  QueueBackend backend) {
+    long long n = pristine.size();
+    Sampler sampler;
+    for (long long rep = 0; rep < repetitions(n); rep++) {
+        std::vector<Process> processes = pristine;
+        BasicPriorityQueue<Policy> queue(AGING_FACTOR, AgingMode::Lazy, backend);
+        for (auto& process : processes) {
+            queue.insert(&process);
+        }
+        queue.applyAging(n);
+        for (long long begin = 0; begin < n; begin += batchSize(n)) {
+            long long end = std::min(n, begin + batchSize(n));
+            sampler.time(end - begin, [&]() {
+                for (long long i = begin; i < end; i++) {
+                    queue.extractMin();
+                }
+            });
+        }
+    }
+    report.add(sampler.result("pq_extract_min", variantName<Policy>(backend), n));
+}
+
+// One op = one applyAging() call with n queued. Lazy is O(1), Eager O(n).
+void benchApplyAging(BenchmarkReport& report, std::vector<Process>& processes, AgingMode mode) {
+    long long n = processes.size();
+    PriorityQueue queue(AGING_FACTOR, mode);
+    for (auto& process : processes) {
+        queue.insert(&process);
+    }
+
+    Sampler sampler;
+    long long now = n;
+    if (mode == AgingMode::Lazy) {
+        for (int batch = 0; batch < 64; batch++) {
+            sampler.time(1000, [&]() {
+                for (int i = 0; i < 1000; i++) {
+                    queue.applyAging(++now);
+                }
+            });
+        }
+    } else {
+        long long calls = std::max(5LL, std::min(1000LL, 10 * TARGET_OPS / n));
+        for (long long i = 0; i < calls; i++) {
+            sampler.time(1, [&]() { queue.applyAging(++now); });
+        }
+    }
+    report.add(sampler.result("pq_apply_aging", mode == AgingMode::Lazy ? "lazy" : "eager", n));
+}
+
+// One op = one full rebuildHeap() with n queued
+void benchRebuild(BenchmarkReport& report, std::vector<Process>& processes) {
+    long long n = processes.size();
+    PriorityQueue queue(AGING_FACTOR);
+    for (auto& process : processes) {
+        queue.insert(&process);
+    }
+
+    Sampler sampler;
+    long long calls = std::max(5LL, std::min(1000LL, 10 * TARGET_OPS / n));
+    for (long long i = 0; i < calls; i++) {
+        sampler.time(1, [&]() { queue.rebuildHeap(); });
+    }
+    report.add(sampler.result("pq_rebuild_heap", "heap", n));
+}
+
+// One op = one process scheduled by Scheduler::run (non-verbose)
+template <typename Policy = LinearAging>
+void benchSchedulerRun(BenchmarkReport& report, const std::vector<Process>& pristine) {
+    long long n = pristine.size();
+    Sampler sampler;
+    long long reps = std::max(3LL, std::min(100LL, TARGET_OPS / n));
+    for (long long rep = 0; rep < reps; rep++) {
+        BasicScheduler<Policy> scheduler(AGING_FACTOR, false);
+        for (const auto& process : pristine) {
+            // Arrivals every ~5 units against a mean burst of 5.5: a
+            // slightly overloaded CPU, so the queue stays populated
+            scheduler.addProcess(process.getId(), process.getBasePriority(),
+                                 process.getArrivalTime() * 5, process.getBurstTime());
+        }
+        sampler.time(n, [&]() { scheduler.run(); });
+    }
+    report.add(sampler.result("scheduler_run", Policy::FIXED_POINT ? "event-fixed" : "event", n));
+}
+
+// One op = one job streamed out of the workload generator
+void benchGenerate(BenchmarkReport& report, long long n) {
+    Sampler sampler;
+    for (long long rep = 0; rep < repetitions(n); rep++) {
+        WorkloadGenerator generator(benchWorkload(n));
+        TraceRecord record;
+        for (long long begin = 0; begin < n; begin += batchSize(n)) {
+            long long end = std::min(n, begin + batchSize(n));
+            sampler.time(end - begin, [&]() {
+                for (long long i = begin; i < end; i++) {
+                    generator.next(record);
+                }
+            });
+        }
+    }
+    report.add(sampler.result("workload_generate", "poisson", n));
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    long long min_size = 100;
+    long long max_size = 10000000;
+    std::string json_path;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--min-size" && i + 1 < argc) {
+            min_size = std::atoll(argv[++i]);
+        } else if (arg == "--max-size" && i + 1 < argc) {
+            max_size = std::atoll(argv[++i]);
+        } else if (arg == "--json" && i + 1 < argc) {
+            json_path = argv[++i];
+        } else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--min-size N] [--max-size N] [--json FILE]" << std::endl;
+            return 1;
+        }
+    }
+
+    BenchmarkReport report;
+    BenchmarkReport::printHeader();
+
+    for (long long n = std::max(1LL, min_size); n <= max_size; n *= 10) {
+        std::vector<Process> pristine = makeProcesses(n);
+
+        benchInsert(report, pristine, QueueBackend::Heap);
+        benchInsert(report, pristine, QueueBackend::Bucket);
+        benchInsert<FixedPointAging>(report, pristine, QueueBackend::Heap);
+        benchExtract(report, pristine, QueueBackend::Heap);
+        benchExtract(report, pristine, QueueBackend::Bucket);
+        benchExtract<FixedPointAging>(report, pristine, QueueBackend::Heap);
+
+        std::vector<Process> processes = pristine;
+        benchApplyAging(report, processes, AgingMode::Lazy);
+        processes = pristine;
+        benchApplyAging(report, processes, AgingMode::Eager);
+        processes = pristine;
+        benchRebuild(report, processes);
+
+        benchSchedulerRun(report, pristine);
+        benchSchedulerRun<FixedPointAging>(report, pristine);
+        benchGenerate(report, n);
+    }
+
+    if (!json_path.empty()) {
+        if (!report.writeJson(json_path)) {
+            std::cerr << "Cannot write " << json_path << std::endl;
+            return 1;
+        }
+        std::cout << "\nResults written to " << json_path << std::endl;
+    }
+    return 0;
+}
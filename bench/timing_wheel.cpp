@@ -0,0 +1,93 @@
+// Timer queue for blocked processes: hierarchical timing wheel vs 4-ary heap.
+//
+// Hold model: n timers pending; the earliest one fires, time jumps to it
+// and a new timer is scheduled a random delay ahead, so n stays constant
+// (one I/O completion and one new I/O request per step). Delays are drawn
+// uniformly from 1..max_delay; the wheel uses next-expiry jumps like the
+// event engine.
+// ns per timer (schedule + expire), lower is better.
+
+#include "Heap.h"
+#include "TimingWheel.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+const long long WORK_PER_POINT = 4000000;   // Timers fired per measurement
+
+double elapsedNs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+std::vector<long long> delays(long long count, long long max_delay) {
+    std::mt19937_64 gen(42);
+    std::uniform_int_distribution<long long> dist(1, max_delay);
+    std::vector<long long> out(count);
+    for (auto& d : out) {
+        d = dist(gen);
+    }
+    return out;
+}
+
+// Both return a checksum of the fired payloads so the loops are not elided
+
+double measureWheel(long long n, const std::vector<long long>& delay, long long& checksum) {
+    TimingWheel<uint32_t> wheel;
+    size_t next = 0;
+    for (long long i = 0; i < n; i++) {
+        wheel.schedule(delay[next++ % delay.size()], static_cast<uint32_t>(i));
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (long long fired = 0; fired < WORK_PER_POINT; fired++) {
+        if (!wheel.hasDue()) {
+            wheel.advance(wheel.nextExpiry());
+        }
+        long long now = wheel.dueTime();
+        uint32_t payload = wheel.popDue();
+        checksum += payload;
+        wheel.schedule(now + delay[next++ % delay.size()], payload);
+    }
+    return elapsedNs(start) / WORK_PER_POINT;
+}
+
+double measureHeap(long long n, const std::vector<long long>& delay, long long& checksum) {
+    Heap<long long, uint32_t> heap;
+    size_t next = 0;
+    for (long long i = 0; i < n; i++) {
+        heap.push(delay[next++ % delay.size()], static_cast<uint32_t>(i));
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (long long fired = 0; fired < WORK_PER_POINT; fired++) {
+        auto top = heap.pop();
+        checksum += top.payload;
+        heap.push(top.key + delay[next++ % delay.size()], top.payload);
+    }
+    return elapsedNs(start) / WORK_PER_POINT;
+}
+
+}
+
+int main() {
+    std::cout << "Timer queue, hold model (ns per timer, lower is better)" << std::endl;
+    std::cout << std::left << std::setw(10) << "Pending" << std::setw(12) << "Max delay"
+              << std::setw(12) << "Heap" << "Timing wheel" << std::endl;
+    std::cout << std::string(46, '-') << std::endl;
+
+    long long checksum = 0;
+    for (long long n = 1000; n <= 1000000; n *= 10) {
+        for (long long max_delay : {100LL, 10000LL, 1000000LL}) {
+            std::vector<long long> delay = delays(1 << 20, max_delay);
+            double heap_ns = measureHeap(n, delay, checksum);
+            double wheel_ns = measureWheel(n, delay, checksum);
+            std::cout << std::left << std::setw(10) << n << std::setw(12) << max_delay
+                      << std::fixed << std::setprecision(1)
+                      << std::setw(12) << heap_ns << wheel_ns << std::endl;
+        }
+    }
+    std::cout << "(checksum " << checksum << ")" << std::endl;
+    return 0;
+}
@@ -0,0 +1,43 @@
+#ifndef AGING_KERNEL_H
+#define AGING_KERNEL_H
+
+#include <cstddef>
+
+// Bulk effective-priority recompute for eager aging.
+//
+// Works on contiguous per-entry arrays instead of chasing Process pointers:
+//
+//   waited       = max(0, time - origin[i])
+//   effective[i] = max(0, base[i] - min(floor(waited / step) * step * factor, cap))
+//
+// which is LinearAging (step 1, no cap), StepAging<K> (step K) and
+// CappedAging<M> (cap M), rounded exactly like their scalar effective().
+// Entries with origin = +infinity never age (unused slots). Returns how many
+// entries changed value, counted without branches, so callers can skip the
+// heapify when nothing moved.
+//
+// The AVX2 and AVX-512 versions are compiled alongside the scalar one and
+// picked at run time from the CPU's features (x86 with GCC or Clang; other
+// targets always use the scalar loop).
+
+struct AgingShape {
+    double step;    // Waiting time is rounded down to a multiple of step
+    double cap;     // Largest boost (infinity = none)
+};
+
+enum class AgingKernel {
+    Auto,           // Widest the CPU supports
+    Scalar,
+    Avx2,
+    Avx512
+};
+
+size_t recomputeEffective(const double* origin, const double* base, double* effective,
+                          size_t count, long long time, double factor, AgingShape shape);
+
+// Forces a kernel (benchmarks); one the CPU lacks falls back to Auto
+void setAgingKernel(AgingKernel kernel);
+AgingKernel activeAgingKernel();
+const char* agingKernelName(AgingKernel kernel);
+
+#endif // AGING_KERNEL_H
@@ -0,0 +1,214 @@
+#ifndef AGING_POLICY_H
+#define AGING_POLICY_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+// Aging rules. A policy turns a process's base priority and the time it has
+// waited into its effective priority (lower is more urgent), given the
+// run-time aging factor:
+//
+//   effective(base, waited, factor)
+//   agingEvents(base, from, to, factor): ticks waited in [from, to) that
+//       moved the priority by more than 0.01 (the "aging events" statistic)
+//   key(base, origin, factor), origin = arrival + executed + blocked time
+//       (Process::getReadyOrigin())
+//
+// When ORDER_INVARIANT, ordering queued processes by key orders them by
+// effective priority at every point in time, so a queue never has to
+// recompute while time passes (lazy aging), and effectiveFromKey() recovers
+// the effective priority. Otherwise the key is only a tie-break and queues
+// recompute every effective priority as time advances (eager aging).
+//
+// Key is the key's type: double, or for FIXED_POINT policies an exact
+// 64-bit integer into which queues pack a FIFO sequence (pack()), so queued
+// processes compare with one integer compare.
+//
+// PIECEWISE_LINEAR policies also give their rule as
+//   max(0, base - min(floor(waited / STEP) * STEP * factor, CAP))
+// so eager queues recompute them in bulk with the vector kernel
+// (AgingKernel.h) instead of one process at a time.
+//
+// Policies are types: BasicPriorityQueue and BasicScheduler are templates
+// over them, so the rule and its constants are inlined into the hot path.
+
+// base - waited * factor, floored at 0 (the default)
+struct LinearAging {
+    using Key = double;
+    static constexpr bool ORDER_INVARIANT = true;
+    static constexpr bool PIECEWISE_LINEAR = true;
+    static constexpr bool FIXED_POINT = false;
+    static constexpr double STEP = 1.0;
+    static constexpr double CAP = std::numeric_limits<double>::infinity();
+    static constexpr const char* NAME = "linear";
+
+    static double effective(int base, long long waited, double factor) {
+        return std::max(0.0, base - waited * factor);
+    }
+    // effective = key - t * factor, the same shift for every queued process
+    static double key(int base, long long origin, double factor) {
+        return base + origin * factor;
+    }
+    static double effectiveFromKey(double key, long long time, double factor) {
+        return std::max(0.0, key - time * factor);
+    }
+    static long long agingEvents(int base, long long from, long long to, double factor) {
+        if (factor <= 0.01) {
+            return 0;
+        }
+        long long ticks_to_floor = static_cast<long long>(std::ceil(base / factor));
+        return std::max(0LL, std::min(to, ticks_to_floor) - std::min(from, ticks_to_floor));
+    }
+};
+
+// base * e^(-waited * factor): fast relief at first, never reaching 0
+struct ExponentialAging {
+    using Key = double;
+    static constexpr bool ORDER_INVARIANT = true;
+    static constexpr bool PIECEWISE_LINEAR = false;
+    static constexpr bool FIXED_POINT = false;
+    static constexpr const char* NAME = "exponential";
+
+    static double effective(int base, long long waited, double factor) {
+        return base * std::exp(-static_cast<double>(waited) * factor);
+    }
+    // effective = e^(key - t * factor), so the log-priority is a linear key
+    static double key(int base, long long origin, double factor) {
+        return base > 0 ? std::log(static_cast<double>(base)) + origin * factor : -HUGE_VAL;
+    }
+    static double effectiveFromKey(double key, long long time, double factor) {
+        return std::exp(key - time * factor);
+    }
+    static long long agingEvents(int base, long long from, long long to, double factor) {
+        // The per-tick drop base * e^(-w f) * (1 - e^-f) exceeds 0.01 while
+        // w is below limit
+        if (factor <= 0.0 || base <= 0) {
+            return 0;
+        }
+        double ratio = base * -std::expm1(-factor) / 0.01;
+        if (ratio <= 1.0) {
+            return 0;
+        }
+        long long limit = static_cast<long long>(std::ceil(std::log(ratio) / factor));
+        return std::max(0LL, std::min(to, limit) - std::min(from, limit));
+    }
+};
+
+// The linear rate applied in steps of Ticks * factor every Ticks waited
+template <int Ticks = 10>
+struct StepAging {
+    static_assert(Ticks > 0, "StepAging needs a positive step");
+    using Key = double;
+    static constexpr bool ORDER_INVARIANT = false;
+    static constexpr bool PIECEWISE_LINEAR = true;
+    static constexpr bool FIXED_POINT = false;
+    static constexpr double STEP = Ticks;
+    static constexpr double CAP = std::numeric_limits<double>::infinity();
+    static constexpr const char* NAME = "step";
+
+    static double effective(int base, long long waited, double factor) {
+        return std::max(0.0, base - (waited / Ticks) * Ticks * factor);
+    }
+    static double key(int base, long long origin, double factor) {
+        return LinearAging::key(base, origin, factor);
+    }
+    static long long agingEvents(int base, long long from, long long to, double factor) {
+        // One event per step taken above the floor
+        if (Ticks * factor <= 0.01) {
+            return 0;
+        }
+        long long steps_to_floor = static_cast<long long>(std::ceil(base / (Ticks * factor)));
+        return std::max(0LL, std::min(to / Ticks, steps_to_floor) - std::min(from / Ticks, steps_to_floor));
+    }
+};
+
+// Linear, but the boost stops at MaxBoost levels
+template <int MaxBoost = 5>
+struct CappedAging {
+    static_assert(MaxBoost >= 0, "CappedAging needs a non-negative cap");
+    using Key = double;
+    static constexpr bool ORDER_INVARIANT = false;
+    static constexpr bool PIECEWISE_LINEAR = true;
+    static constexpr bool FIXED_POINT = false;
+    static constexpr double STEP = 1.0;
+    static constexpr double CAP = MaxBoost;
+    static constexpr const char* NAME = "capped";
+
+    static double effective(int base, long long waited, double factor) {
+        return std::max(0.0, base - std::min(waited * factor, static_cast<double>(MaxBoost)));
+    }
+    static double key(int base, long long origin, double factor) {
+        return LinearAging::key(base, origin, factor);
+    }
+    static long long agingEvents(int base, long long from, long long to, double factor) {
+        return LinearAging::agingEvents(std::min(base, MaxBoost), from, to, factor);
+    }
+};
+
+// Linear aging in fixed point. Priorities and the factor are counted in
+// units of 1/4096 (the factor rounds to the nearest unit: 0.1 is 410/4096),
+// so every value is exact and schedules are bit-identical across platforms,
+// compilers and flags. Queues pack a FIFO sequence under the key,
+//
+//   (base * 4096 + origin * factor_units) << 24 | sequence
+//
+// which makes keys distinct: equal priorities leave in insertion order.
+// The key keeps 40 bits (origin below about 2.7 * 10^9 at factor 0.1);
+// queues check fits() whenever a key changes and throw
+// std::overflow_error rather than truncate it. A queue holds at most 2^24
+// processes (SEQUENCE_LIMIT) and refuses more the same way. Always Lazy.
+struct FixedPointAging {
+    using Key = uint64_t;
+    static constexpr bool ORDER_INVARIANT = true;
+    static constexpr bool PIECEWISE_LINEAR = false;
+    static constexpr bool FIXED_POINT = true;
+    static constexpr int FRACTION_BITS = 12;
+    static constexpr int SEQUENCE_BITS = 24;
+    static constexpr long long ONE = 1LL << FRACTION_BITS;
+    static constexpr uint64_t SEQUENCE_LIMIT = 1ULL << SEQUENCE_BITS;
+    static constexpr long long KEY_LIMIT = 1LL << (64 - SEQUENCE_BITS);
+    static constexpr const char* NAME = "fixed";
+
+    // The factor in units of 1/ONE per time unit
+    static long long factorUnits(double factor) {
+        return std::llround(factor * ONE);
+    }
+    static double effective(int base, long long waited, double factor) {
+        long long value = std::max(0LL, base * ONE - waited * factorUnits(factor));
+        return static_cast<double>(value) / ONE;
+    }
+    // effective = (key - t * factor_units) / ONE; without the sequence
+    static Key key(int base, long long origin, double factor) {
+        return static_cast<Key>(base * ONE + origin * factorUnits(factor));
+    }
+    // Whether key(base, origin, factor) is below KEY_LIMIT, so pack()
+    // keeps all of it; computed without overflowing
+    static bool fits(int base, long long origin, double factor) {
+        if (base < 0 || origin < 0 || !(factor * ONE < KEY_LIMIT)) {
+            return false;
+        }
+        long long units = factorUnits(factor);
+        long long room = KEY_LIMIT - 1 - base * ONE;
+        return room >= 0 && (units == 0 || origin <= room / units);
+    }
+    static Key pack(Key key, uint64_t sequence) {
+        return key << SEQUENCE_BITS | (sequence & (SEQUENCE_LIMIT - 1));
+    }
+    static double effectiveFromKey(Key key, long long time, double factor) {
+        long long value = std::max(0LL, static_cast<long long>(key) - time * factorUnits(factor));
+        return static_cast<double>(value) / ONE;
+    }
+    // Exact: every tick waited above the floor lowers the priority
+    static long long agingEvents(int base, long long from, long long to, double factor) {
+        long long step = factorUnits(factor);
+        if (step <= 0 || base <= 0) {
+            return 0;
+        }
+        long long ticks_to_floor = (base * ONE + step - 1) / step;
+        return std::max(0LL, std::min(to, ticks_to_floor) - std::min(from, ticks_to_floor));
+    }
+};
+
+#endif // AGING_POLICY_H
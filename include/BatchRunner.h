@@ -0,0 +1,109 @@
+#ifndef BATCH_RUNNER_H
+#define BATCH_RUNNER_H
+
+#include "ParameterSweep.h"
+#include "PriorityQueue.h"
+#include "Telemetry.h"
+#include "Trace.h"
+#include "WorkloadGenerator.h"
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// Aging policy types (AgingPolicy.h) selectable at run time; each picks a
+// scheduler specialized on that policy
+enum class AgingRule {
+    Linear,
+    Exponential,
+    Step,           // StepAging<>: every 10 time units
+    Capped,         // CappedAging<>: at most 5 levels
+    FixedPoint      // FixedPointAging: linear on exact integer keys
+};
+
+enum class OutputFormat {
+    Text,
+    Json,
+    Csv
+};
+
+// Everything a headless run needs. Defaults match the interactive demo.
+struct BatchConfig {
+    // Workload: a trace file, or generated processes (count > 0)
+    std::string trace_path;
+    TraceFormat trace_format = TraceFormat::Auto;
+    WorkloadSpec workload{WorkloadSpec::DEFAULT_SEED, 0, ArrivalPattern::Uniform, 20};
+    int load_threads = 0;               // Trace parsing / generation threads (0 = auto)
+
+    // Policy
+    double aging_factor = 0.1;
+    AgingRule aging_rule = AgingRule::Linear;   // Single core; other rules use Eager/heap
+    AgingMode aging_mode = AgingMode::Lazy;
+    QueueBackend backend = QueueBackend::Heap;
+    bool preemptive = false;
+    int time_quantum = 0;
+    long long queue_capacity = 0;       // Single core; 0 = unbounded
+    OverflowPolicy overflow = OverflowPolicy::Reject;
+
+    // Multi-core (cores > 1 uses MultiCoreScheduler)
+    int cores = 1;
+    long long sync_interval = 10;
+    long long migration_cost = 1;
+    int host_threads = 0;
+
+    // Output
+    OutputFormat format = OutputFormat::Text;
+    bool per_process = false;
+
+    // Telemetry CSV (single core): a sample every telemetry_interval time
+    // units, the last telemetry_capacity kept
+    std::string telemetry_path;
+    long long telemetry_interval = Telemetry::DEFAULT_INTERVAL;
+    long long telemetry_capacity = Telemetry::DEFAULT_CAPACITY;
+
+    // Execution slices: Chrome / Perfetto trace JSON and/or a console Gantt
+    // chart (text output)
+    std::string chrome_trace_path;
+    bool gantt = false;
+
+    // Write the workload as a binary trace and exit instead of simulating
+    std::string convert_path;
+
+    // Parameter sweep (runs when sweep_factors is set): factors x policies x
+    // workloads. Workloads are the sweep traces and one generated workload
+    // per sweep seed, or the workload above if neither is given; the policy
+    // defaults to the one above.
+    std::vector<double> sweep_factors;
+    std::vector<SweepPolicy> sweep_policies;
+    std::vector<std::string> sweep_traces;
+    std::vector<uint64_t> sweep_seeds;
+    int sweep_threads = 0;
+};
+
+// Non-interactive mode of aging_demo: configured from command-line flags
+// and/or a key=value config file, runs one simulation with verbose output
+// off and prints only the results.
+class BatchRunner {
+public:
+    // Exit codes
+    static constexpr int EXIT_OK = 0;
+    static constexpr int EXIT_USAGE = 1;
+    static constexpr int EXIT_INPUT = 2;
+
+    // Parses argv (flags override a --config file given anywhere on the
+    // line). Returns false with a message in error on bad input.
+    static bool parseArguments(int argc, char* argv[], BatchConfig& config, std::string& error,
+                               bool& show_help);
+    static bool loadConfigFile(const std::string& path, BatchConfig& config, std::string& error);
+
+    // Applies one option (flag name without dashes, or config file key)
+    static bool applyOption(const std::string& key, const std::string& value,
+                            BatchConfig& config, std::string& error);
+
+    static int run(const BatchConfig& config);
+    static int convert(const BatchConfig& config);
+    static int sweep(const BatchConfig& config);
+    static int main(int argc, char* argv[]);
+    static void printUsage(std::ostream& out, const char* program);
+};
+
+#endif // BATCH_RUNNER_H
@@ -0,0 +1,381 @@
+#ifndef BUCKET_QUEUE_H
+#define BUCKET_QUEUE_H
+
+#include "Heap.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Bucketed priority queue for keys that fall into a few integer levels
+// (e.g. base priorities 1-10).
+//
+// Each level is a FIFO plus a small overflow heap. Within a level, entries
+// usually arrive in key order (a process's aging key grows with its arrival
+// time), so push appends to the FIFO in O(1); an entry that would break the
+// FIFO order goes to the overflow heap instead. A bitmap tracks non-empty
+// levels, and top/pop compare only the heads of those levels, O(L) for L
+// levels in use, independent of the number of entries.
+//
+// The order is exactly the one Compare gives: the FIFO is only appended to
+// in order, the overflow is a heap, and levels are merged by comparing heads.
+//
+// Levels in use span at most MAX_LEVEL_SPAN consecutive values; an entry
+// whose level falls outside that window (e.g. one stray priority of 2 * 10^9)
+// goes to a shared far level, a plain heap, instead of allocating every
+// level in between.
+//
+// Like Heap with TrackPositions, the payload must be a small dense integer.
+// erase is O(1) for FIFO entries, which are only marked stale and dropped
+// when they reach either end of the FIFO, and O(log n) for overflow entries.
+// Stale entries are never passed to Compare, so it may look up payloads
+// that have since been reused.
+template <typename Key, typename Payload = uint32_t, typename Compare = HeapKeyLess>
+class BucketQueue {
+public:
+    using Node = HeapNode<Key, Payload>;
+    static constexpr std::size_t MAX_LEVEL_SPAN = std::size_t(1) << 16;
+
+private:
+    static constexpr std::size_t NONE = static_cast<std::size_t>(-1);
+    static constexpr std::size_t FAR = NONE - 1;     // Index of the far level
+
+    struct Entry {
+        Node node;
+        uint32_t stamp;  // Matches the payload's location while live
+    };
+
+    struct Level {
+        std::vector<Entry> fifo;     // Live range starts at head
+        std::size_t head = 0;
+        std::size_t checked = NONE;  // fifo[checked] is known to be live
+        std::vector<Node> overflow;  // Binary heap of out-of-order entries
+        std::size_t live = 0;
+    };
+
+    struct Location {
+        int level = 0;
+        uint32_t stamp = 0;
+        bool queued = false;
+        bool in_overflow = false;
+        bool far = false;            // In the far level (always its heap)
+        std::size_t index = 0;       // Position in the overflow heap
+    };
+
+    mutable std::vector<Level> levels;  // Index = level - lowest
+    mutable Level far;                  // Levels outside the window
+    int lowest;
+    std::vector<uint64_t> occupied;     // Bit per level with live entries
+    std::vector<Location> locations;    // Payload -> where its live entry is
+    std::size_t count;
+    Compare compare;
+
+    static int lowestBit(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(word);
+#else
+        int bit = 0;
+        while (!(word & 1)) {
+            word >>= 1;
+            bit++;
+        }
+        return bit;
+#endif
+    }
+
+    bool live(const Entry& entry) const {
+        const Location& location = locations[static_cast<std::size_t>(entry.node.payload)];
+        return location.queued && !location.in_overflow && location.stamp == entry.stamp;
+    }
+
+    Level& levelAt(std::size_t index) const { return index == FAR ? far : levels[index]; }
+
+    void mark(std::size_t index, bool set) {
+        if (index == FAR) {
+            return;
+        }
+        if (set) {
+            occupied[index / 64] |= uint64_t(1) << (index % 64);
+        } else {
+            occupied[index / 64] &= ~(uint64_t(1) << (index % 64));
+        }
+    }
+
+    // Make room for a level and return its index, FAR if that would stretch
+    // the window past MAX_LEVEL_SPAN
+    std::size_t levelIndex(int level) {
+        if (levels.empty()) {
+            lowest = level;
+        }
+        long long span = std::max<long long>(static_cast<long long>(levels.size()),
+                                             static_cast<long long>(level) - lowest + 1) +
+                         std::max<long long>(0, static_cast<long long>(lowest) - level);
+        if (span > static_cast<long long>(MAX_LEVEL_SPAN)) {
+            return FAR;
+        }
+        if (level < lowest) {
+            // Rare: shift existing levels up and rebuild the bitmap
+            levels.insert(levels.begin(), static_cast<std::size_t>(lowest - level), Level());
+            lowest = level;
+            occupied.assign((levels.size() + 63) / 64, 0);
+            for (std::size_t i = 0; i < levels.size(); i++) {
+                if (levels[i].live > 0) {
+                    mark(i, true);
+                }
+            }
+        }
+        std::size_t index = static_cast<std::size_t>(level - lowest);
+        if (index >= levels.size()) {
+            levels.resize(index + 1);
+            occupied.resize((levels.size() + 63) / 64, 0);
+        }
+        return index;
+    }
+
+    // Overflow heap: every write records the position for erase
+    void place(std::vector<Node>& heap, std::size_t i, const Node& node) {
+        heap[i] = node;
+        locations[static_cast<std::size_t>(node.payload)].index = i;
+    }
+
+    void siftUp(std::vector<Node>& heap, std::size_t index) {
+        Node moving = heap[index];
+        while (index > 0) {
+            std::size_t parent = (index - 1) / 2;
+            if (!compare(moving, heap[parent])) {
+                break;
+            }
+            place(heap, index, heap[parent]);
+            index = parent;
+        }
+        place(heap, index, moving);
+    }
+
+    void siftDown(std::vector<Node>& heap, std::size_t index) {
+        Node moving = heap[index];
+        while (true) {
+            std::size_t child = 2 * index + 1;
+            if (child >= heap.size()) {
+                break;
+            }
+            if (child + 1 < heap.size() && compare(heap[child + 1], heap[child])) {
+                child++;
+            }
+            if (!compare(heap[child], moving)) {
+                break;
+            }
+            place(heap, index, heap[child]);
+            index = child;
+        }
+        place(heap, index, moving);
+    }
+
+    void removeOverflow(std::vector<Node>& heap, std::size_t index) {
+        std::size_t last = heap.size() - 1;
+        if (index != last) {
+            place(heap, index, heap[last]);
+            heap.pop_back();
+            if (index > 0 && compare(heap[index], heap[(index - 1) / 2])) {
+                siftUp(heap, index);
+            } else {
+                siftDown(heap, index);
+            }
+        } else {
+            heap.pop_back();
+        }
+    }
+
+    // Best live entry of a non-empty level; drops stale FIFO entries in front
+    const Node& levelHead(Level& level) const {
+        // Skipping the liveness check on repeat visits saves a random access
+        // per level on every top/pop
+        if (level.checked != level.head) {
+            while (level.head < level.fifo.size() && !live(level.fifo[level.head])) {
+                level.head++;
+            }
+            level.checked = level.head < level.fifo.size() ? level.head : NONE;
+        }
+        if (level.head == level.fifo.size()) {
+            return level.overflow.front();
+        }
+        if (level.overflow.empty() || compare(level.fifo[level.head].node, level.overflow.front())) {
+            return level.fifo[level.head].node;
+        }
+        return level.overflow.front();
+    }
+
+    // Level holding the overall minimum
+    std::size_t bestLevel() const {
+        std::size_t best = 0;
+        const Node* best_node = nullptr;
+        for (std::size_t word = 0; word < occupied.size(); word++) {
+            for (uint64_t bits = occupied[word]; bits; bits &= bits - 1) {
+                std::size_t index = word * 64 + lowestBit(bits);
+                const Node& head = levelHead(levels[index]);
+                if (!best_node || compare(head, *best_node)) {
+                    best_node = &head;
+                    best = index;
+                }
+            }
+        }
+        if (far.live > 0 && (!best_node || compare(far.overflow.front(), *best_node))) {
+            best = FAR;
+        }
+        return best;
+    }
+
+    // One fewer live entry in a level; empty levels release their stale entries
+    void release(std::size_t index) {
+        Level& level = levelAt(index);
+        if (--level.live == 0) {
+            level.fifo.clear();
+            level.head = 0;
+            level.checked = NONE;
+            mark(index, false);
+        }
+        count--;
+    }
+
+public:
+    explicit BucketQueue(Compare compare = Compare())
+        : lowest(0), count(0), compare(compare) {
+    }
+
+    // Core operations
+    void push(int level, const Key& key, const Payload& payload) {
+        std::size_t index = levelIndex(level);
+        std::size_t p = static_cast<std::size_t>(payload);
+        if (p >= locations.size()) {
+            locations.resize(p + 1);
+        }
+        Location& location = locations[p];
+        location.level = level;
+        location.stamp++;
+        location.queued = true;
+        location.in_overflow = false;
+        location.far = index == FAR;
+
+        Node node{key, payload};
+        Level& bucket = levelAt(index);
+        // Stale entries at the back must not be compared against
+        while (bucket.fifo.size() > bucket.head && !live(bucket.fifo.back())) {
+            bucket.fifo.pop_back();
+        }
+        if (!location.far &&
+            (bucket.head == bucket.fifo.size() || !compare(node, bucket.fifo.back().node))) {
+            bucket.fifo.push_back(Entry{node, location.stamp});
+        } else {
+            location.in_overflow = true;
+            bucket.overflow.push_back(node);
+            siftUp(bucket.overflow, bucket.overflow.size() - 1);
+        }
+        if (bucket.live++ == 0) {
+            mark(index, true);
+        }
+        count++;
+    }
+
+    Node pop() {
+        std::size_t index = bestLevel();
+        Level& level = levelAt(index);
+        Node top = levelHead(level);
+        Location& location = locations[static_cast<std::size_t>(top.payload)];
+
+        if (location.in_overflow) {
+            removeOverflow(level.overflow, 0);
+        } else {
+            level.head++;
+            // Reclaim the consumed prefix once it dominates the buffer
+            if (level.head >= 1024 && level.head * 2 >= level.fifo.size()) {
+                level.fifo.erase(level.fifo.begin(), level.fifo.begin() + level.head);
+                level.head = 0;
+                level.checked = NONE;
+            }
+        }
+
+        location.queued = false;
+        release(index);
+        return top;
+    }
+
+    const Node& top() const { return levelHead(levelAt(bestLevel())); }
+
+    // Addressable operations
+    bool contains(const Payload& payload) const {
+        std::size_t p = static_cast<std::size_t>(payload);
+        return p < locations.size() && locations[p].queued;
+    }
+
+    void erase(const Payload& payload) {
+        Location& location = locations[static_cast<std::size_t>(payload)];
+        std::size_t index = location.far ? FAR : static_cast<std::size_t>(location.level - lowest);
+        if (location.in_overflow) {
+            removeOverflow(levelAt(index).overflow, location.index);
+            location.in_overflow = false;
+        } else {
+            levels[index].checked = NONE;
+        }
+        location.queued = false;
+        release(index);
+    }
+
+    void update(const Payload& payload, int level, const Key& key) {
+        erase(payload);
+        push(level, key, payload);
+    }
+
+    // Visit every live node (unordered)
+    template <typename Fn>
+    void forEach(Fn fn) const {
+        for (const Level& level : levels) {
+            for (std::size_t i = level.head; i < level.fifo.size(); i++) {
+                if (live(level.fifo[i])) {
+                    fn(level.fifo[i].node);
+                }
+            }
+            for (const Node& node : level.overflow) {
+                fn(node);
+            }
+        }
+        for (const Node& node : far.overflow) {
+            fn(node);
+        }
+    }
+
+    // Recompute every key with fn(node), which returns the node's level, and
+    // rebuild. Entries are re-pushed in order so they all land in FIFOs.
+    template <typename Fn>
+    void rekey(Fn fn) {
+        std::vector<std::pair<int, Node>> nodes;
+        nodes.reserve(count);
+        forEach([&nodes](const Node& node) { nodes.emplace_back(0, node); });
+        for (auto& entry : nodes) {
+            entry.first = fn(entry.second);
+        }
+        std::sort(nodes.begin(), nodes.end(),
+                  [this](const std::pair<int, Node>& a, const std::pair<int, Node>& b) {
+                      return compare(a.second, b.second);
+                  });
+        clear();
+        for (const auto& entry : nodes) {
+            push(entry.first, entry.second.key, entry.second.payload);
+        }
+    }
+
+    // State
+    bool empty() const { return count == 0; }
+    std::size_t size() const { return count; }
+    void clear() {
+        levels.clear();
+        far = Level();
+        occupied.clear();
+        for (Location& location : locations) {
+            location.queued = false;
+            location.in_overflow = false;
+        }
+        count = 0;
+    }
+};
+
+#endif // BUCKET_QUEUE_H
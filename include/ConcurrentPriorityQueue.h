@@ -0,0 +1,91 @@
+#ifndef CONCURRENT_PRIORITY_QUEUE_H
+#define CONCURRENT_PRIORITY_QUEUE_H
+
+#include "Process.h"
+#include "Heap.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Relaxed concurrent aging queue for multi-producer/multi-consumer use
+// (MultiQueue, Rihani/Sanders/Dementiev 2015).
+//
+// The queue is split into c * p shards (p = expected number of threads),
+// each a 4-ary heap behind its own mutex. insert() pushes into a random
+// shard; extractMin() samples two random shards, compares their cached top
+// keys without locking and pops from the better one.
+//
+// Aging uses the same time-invariant key as PriorityQueue's lazy mode
+// (base_priority + ready_origin * aging_factor), so shards never need
+// rebuilding and applyAging() is a single atomic store. Effective priority is
+// refreshed when a process is extracted.
+//
+// Ordering guarantee: extraction is not strict. If the queue holds n
+// processes, the rank of the extracted one among them (0 = the true minimum)
+// is O(c * p) in expectation and O(c * p * log(c * p)) with high
+// probability, independent of n, and a process that sits at the top of
+// its shard is removed after O(c * p) extractions in expectation. With one
+// shard the order is strict. The cached top keys are read without a lock,
+// so a concurrent update can make one extraction pick the worse of its two
+// shards; this only widens the constant.
+class ConcurrentPriorityQueue {
+private:
+    // Ties on key fall back to arrival and id, as in PriorityQueue
+    struct ShardOrder {
+        template <typename Node>
+        bool operator()(const Node& a, const Node& b) const {
+            if (a.key != b.key) {
+                return a.key < b.key;
+            }
+            if (a.payload->getArrivalTime() != b.payload->getArrivalTime()) {
+                return a.payload->getArrivalTime() < b.payload->getArrivalTime();
+            }
+            return a.payload->getId() < b.payload->getId();
+        }
+    };
+
+    // Padded to a cache line so neighbouring shards do not false-share
+    struct alignas(64) Shard {
+        std::mutex lock;
+        Heap<double, Process*, 4, ShardOrder> heap;
+        std::atomic<double> top_key;  // +inf when empty; read without the lock
+
+        Shard();
+        void publishTop();
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards;
+    double aging_factor;
+    std::atomic<long long> current_time;
+    std::atomic<long long> count;         // Queued processes (exact once quiescent)
+    std::atomic<long long> aging_events;
+
+    size_t randomShard() const;
+    double agingKey(const Process* process) const;
+
+public:
+    // shards = shards_per_thread * threads (at least 1)
+    ConcurrentPriorityQueue(int threads, int shards_per_thread = 2, double aging_factor = 0.1);
+
+    ConcurrentPriorityQueue(const ConcurrentPriorityQueue&) = delete;
+    ConcurrentPriorityQueue& operator=(const ConcurrentPriorityQueue&) = delete;
+
+    // Core operations (thread-safe)
+    void insert(Process* process);
+    Process* extractMin();          // Near-minimum, nullptr if the queue is empty
+
+    // Aging mechanism: advances the clock only, O(1)
+    void applyAging(long long current_time) { this->current_time.store(current_time, std::memory_order_relaxed); }
+
+    // Queue state
+    bool isEmpty() const { return count.load(std::memory_order_acquire) <= 0; }
+    long long size() const { return count.load(std::memory_order_acquire); }
+    size_t shardCount() const { return shards.size(); }
+
+    // Statistics
+    long long getAgingEvents() const { return aging_events.load(std::memory_order_relaxed); }
+    double getAgingFactor() const { return aging_factor; }
+};
+
+#endif // CONCURRENT_PRIORITY_QUEUE_H
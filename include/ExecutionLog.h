@@ -0,0 +1,60 @@
+#ifndef EXECUTION_LOG_H
+#define EXECUTION_LOG_H
+
+#include <cstddef>
+#include <iosfwd>
+#include <vector>
+
+// One stretch of a process running uninterrupted on one core, [start, end)
+struct ExecutionSlice {
+    int process_id;
+    int core;
+    long long start;
+    long long end;
+};
+
+// Compact record of what ran where and when: one slice per dispatch, so a
+// preempted process has one slice per stretch it ran. Recording appends to
+// the last slice when the same process simply continues (tick-by-tick or
+// across a multi-core epoch), so the log is the same whichever engine made
+// it. Off by default; memory grows with the number of slices.
+class ExecutionLog {
+private:
+    std::vector<ExecutionSlice> slices;
+    bool enabled;
+
+public:
+    explicit ExecutionLog(bool enabled = false) : enabled(enabled) {}
+
+    bool isEnabled() const { return enabled; }
+    void setEnabled(bool on) { enabled = on; }
+
+    void record(int process_id, int core, long long start, long long end) {
+        if (!enabled || end <= start) {
+            return;
+        }
+        if (!slices.empty()) {
+            ExecutionSlice& last = slices.back();
+            if (last.process_id == process_id && last.core == core && last.end == start) {
+                last.end = end;
+                return;
+            }
+        }
+        slices.push_back({process_id, core, start, end});
+    }
+
+    // Adds another log's slices (e.g. per-core logs) and keeps time order
+    void merge(const ExecutionLog& other);
+    void clear() { slices.clear(); }
+
+    const std::vector<ExecutionSlice>& getSlices() const { return slices; }
+    size_t size() const { return slices.size(); }
+    bool empty() const { return slices.empty(); }
+    long long getEndTime() const;
+
+    // Chrome / Perfetto trace event JSON: one complete event per slice on
+    // one track per core, 1 time unit = 1 us
+    void writeChromeTrace(std::ostream& out) const;
+};
+
+#endif // EXECUTION_LOG_H
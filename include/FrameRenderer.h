@@ -0,0 +1,81 @@
+#ifndef FRAME_RENDERER_H
+#define FRAME_RENDERER_H
+
+#include "TripleBuffer.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Scheduler state for one frame of the live view
+struct FrameSnapshot {
+    struct Entry {
+        int id;
+        int base_priority;
+        double effective_priority;
+        int remaining;
+    };
+
+    long long time = 0;
+    int running_id = -1;                // -1 = CPU idle
+    int running_priority = 0;
+    int running_remaining = 0;
+    int completed = 0;
+    int total = 0;                      // 0 = unknown (streamed workload)
+    int queue_length = 0;
+    std::vector<Entry> queue;           // Most urgent first, at most QUEUE_ROWS
+    std::string event;                  // Latest event
+};
+
+// Live console view drawn by its own thread.
+//
+// The simulation fills snapshot() and publish()es it into a lock-free
+// triple buffer, which never blocks; the render thread wakes at most
+// max_fps times a second, takes the newest snapshot (older ones are simply
+// skipped) and redraws only the lines that changed, using ANSI cursor
+// movement. Each frame is written with a single write and flush.
+class FrameRenderer {
+public:
+    static constexpr int DEFAULT_FPS = 30;
+    static constexpr size_t QUEUE_ROWS = 10;
+
+private:
+    TripleBuffer<FrameSnapshot> buffer;
+    std::thread thread;
+    std::atomic<bool> active;
+    int max_fps;
+    std::ostream& out;
+
+    // Render thread only
+    std::vector<std::string> shown;     // Lines currently on screen
+    std::string frame;                  // Output for one frame
+
+    void renderLoop();
+    void draw(const FrameSnapshot& snapshot);
+    static void layout(const FrameSnapshot& snapshot, std::vector<std::string>& lines);
+
+public:
+    explicit FrameRenderer(int max_fps = DEFAULT_FPS);
+    FrameRenderer(int max_fps, std::ostream& out);
+    ~FrameRenderer();
+
+    FrameRenderer(const FrameRenderer&) = delete;
+    FrameRenderer& operator=(const FrameRenderer&) = delete;
+
+    // Clears the screen and starts the render thread
+    void start();
+    // Draws the last published snapshot and joins the render thread
+    void stop();
+
+    // Producer side: fill the snapshot, then publish it
+    FrameSnapshot& snapshot() { return buffer.writeBuffer(); }
+    void publish() { buffer.publish(); }
+    // True once the render thread took the last snapshot; lets the producer
+    // build snapshots no faster than frames are drawn
+    bool ready() const { return !buffer.fresh(); }
+};
+
+#endif // FRAME_RENDERER_H
@@ -0,0 +1,357 @@
+#ifndef HEAP_H
+#define HEAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+// Allocator returning storage aligned to a cache line, so the heap can place
+// each group of siblings inside one line.
+template <typename T, std::size_t Alignment = 64>
+struct CacheAlignedAllocator {
+    using value_type = T;
+
+    template <typename U>
+    struct rebind { using other = CacheAlignedAllocator<U, Alignment>; };
+
+    CacheAlignedAllocator() = default;
+    template <typename U>
+    CacheAlignedAllocator(const CacheAlignedAllocator<U, Alignment>&) {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+    }
+    void deallocate(T* p, std::size_t) {
+        ::operator delete(p, std::align_val_t(Alignment));
+    }
+
+    template <typename U>
+    bool operator==(const CacheAlignedAllocator<U, Alignment>&) const { return true; }
+    template <typename U>
+    bool operator!=(const CacheAlignedAllocator<U, Alignment>&) const { return false; }
+};
+
+// Heap entry: the ordering key is stored inline next to a compact payload
+// (typically a 32-bit index), so comparisons never leave the heap array.
+template <typename Key, typename Payload>
+struct HeapNode {
+    Key key;
+    Payload payload;
+};
+
+// Work done by a heap's sifts (CountOps only). Sifts move a hole, so a
+// "swap" is one node moved one level, as a swapping heap would swap it.
+struct HeapOpCounts {
+    uint64_t comparisons = 0;
+    uint64_t swaps = 0;
+    uint64_t levels = 0;        // Levels visited by sifts, including the last
+};
+
+// Default ordering: smaller key first
+struct HeapKeyLess {
+    template <typename Node>
+    bool operator()(const Node& a, const Node& b) const { return a.key < b.key; }
+};
+
+// Implicit d-ary min-heap.
+//
+// Layout: logical node i lives at storage[i + Arity - 1], so the children of
+// i (Arity * i + 1 .. Arity * i + Arity) start at storage index
+// Arity * (i + 1). With cache-line aligned storage and
+// sizeof(Node) * Arity a multiple or divisor of 64 bytes, every sibling group
+// starts on a line boundary and a sift-down step touches one line
+// (e.g. 16-byte nodes with Arity 4).
+//
+// Sifts are iterative and move a "hole" instead of swapping, so each level
+// costs one node write.
+//
+// With TrackPositions the payload must be a small dense integer (e.g. a slot
+// index); the heap then records where every payload sits so entries can be
+// updated or erased by payload in O(log n).
+//
+// With CountOps the heap counts comparisons, swaps and sift levels in
+// counts(); without it the counting compiles away.
+template <typename Key, typename Payload = uint32_t, unsigned Arity = 4,
+          typename Compare = HeapKeyLess, bool TrackPositions = false,
+          bool CountOps = false>
+class Heap {
+    static_assert(Arity == 2 || Arity == 4 || Arity == 8, "Heap arity must be 2, 4 or 8");
+
+public:
+    using Node = HeapNode<Key, Payload>;
+    static constexpr std::size_t NPOS = static_cast<std::size_t>(-1);
+
+private:
+    static constexpr std::size_t OFFSET = Arity - 1;
+
+    std::vector<Node, CacheAlignedAllocator<Node>> storage;
+    std::size_t count;
+    Compare compare;
+    std::vector<std::size_t> positions;  // Payload -> heap index (TrackPositions only)
+    HeapOpCounts ops;                    // CountOps only
+
+    bool less(const Node& a, const Node& b) {
+        if constexpr (CountOps) {
+            ops.comparisons++;
+        }
+        return compare(a, b);
+    }
+
+    void countLevel(bool moved) {
+        if constexpr (CountOps) {
+            ops.levels++;
+            ops.swaps += moved;
+        }
+    }
+
+    Node& at(std::size_t i) { return storage[i + OFFSET]; }
+    const Node& at(std::size_t i) const { return storage[i + OFFSET]; }
+
+    // Every node write goes through here so the position map stays in sync
+    void place(std::size_t i, const Node& node) {
+        at(i) = node;
+        if constexpr (TrackPositions) {
+            positions[static_cast<std::size_t>(node.payload)] = i;
+        }
+    }
+
+    void forget(const Payload& payload) {
+        if constexpr (TrackPositions) {
+            positions[static_cast<std::size_t>(payload)] = NPOS;
+        }
+    }
+
+    // Below this many nodes the heap sits in L2 and sift-downs are cheap
+    // enough that popBatch() never selects in bulk
+    static constexpr std::size_t BULK_POP_MIN = 1 << 16;
+
+    // Move the node at index up or down, whichever restores the heap property
+    void restore(std::size_t index) {
+        if (index > 0 && less(at(index), at((index - 1) / Arity))) {
+            siftUp(index);
+        } else {
+            siftDown(index);
+        }
+    }
+
+    void siftUp(std::size_t index) {
+        Node moving = at(index);
+        while (index > 0) {
+            std::size_t parent = (index - 1) / Arity;
+            if (!less(moving, at(parent))) {
+                countLevel(false);
+                break;
+            }
+            countLevel(true);
+            place(index, at(parent));
+            index = parent;
+        }
+        place(index, moving);
+    }
+
+    void siftDown(std::size_t index) {
+        Node moving = at(index);
+        while (true) {
+            std::size_t first = Arity * index + 1;
+            if (first >= count) {
+                break;
+            }
+            std::size_t last = first + Arity < count ? first + Arity : count;
+            std::size_t best = first;
+            for (std::size_t child = first + 1; child < last; child++) {
+                if (less(at(child), at(best))) {
+                    best = child;
+                }
+            }
+            if (!less(at(best), moving)) {
+                countLevel(false);
+                break;
+            }
+            countLevel(true);
+            place(index, at(best));
+            index = best;
+        }
+        place(index, moving);
+    }
+
+public:
+    explicit Heap(Compare compare = Compare())
+        : storage(OFFSET), count(0), compare(compare) {
+    }
+
+    // Core operations
+    void push(const Key& key, const Payload& payload) {
+        if constexpr (TrackPositions) {
+            std::size_t p = static_cast<std::size_t>(payload);
+            if (p >= positions.size()) {
+                positions.resize(p + 1, NPOS);
+            }
+        }
+        storage.push_back(Node{key, payload});
+        siftUp(count++);
+    }
+
+    // Pushes n nodes. A batch at least as large as the heap is appended and
+    // fixed bottom-up (Floyd-style, but only the ancestors of the new nodes
+    // are sifted, level by level), O(n + log size) instead of n sift-ups.
+    void pushBatch(const Node* nodes, std::size_t n) {
+        std::size_t first = count;
+        bool bottom_up = n >= count && n > 1;
+        // Geometric, so a heap growing by small batches still reallocates
+        // O(log n) times rather than on every batch
+        if (storage.size() + n > storage.capacity()) {
+            storage.reserve(std::max(storage.size() + n, 2 * storage.capacity()));
+        }
+        for (std::size_t i = 0; i < n; i++) {
+            if constexpr (TrackPositions) {
+                std::size_t p = static_cast<std::size_t>(nodes[i].payload);
+                if (p >= positions.size()) {
+                    positions.resize(p + 1, NPOS);
+                }
+            }
+            storage.push_back(nodes[i]);
+            place(count, nodes[i]);
+            if (!bottom_up) {
+                siftUp(count);
+            }
+            count++;
+        }
+        if (!bottom_up || count < 2) {
+            return;
+        }
+        // Parents of [first, count), then their parents: deeper nodes have
+        // higher indices, so every subtree is a heap before its root sifts
+        std::size_t low = first > 0 ? (first - 1) / Arity : 0;
+        std::size_t high = (count - 2) / Arity;
+        while (true) {
+            for (std::size_t i = high + 1; i-- > low;) {
+                siftDown(i);
+            }
+            if (low == 0) {
+                break;
+            }
+            low = (low - 1) / Arity;
+            high = (high - 1) / Arity;
+        }
+    }
+
+    Node pop() {
+        Node top = at(0);
+        forget(top.payload);
+        count--;
+        if (count > 0) {
+            at(0) = at(count);
+            storage.pop_back();
+            siftDown(0);
+        } else {
+            storage.pop_back();
+        }
+        return top;
+    }
+
+    const Node& top() const { return at(0); }
+
+    // Pops the k smallest nodes (all if fewer) onto out, smallest first.
+    // When k is at least a quarter of a large heap, the k nodes are selected
+    // (nth_element) and sorted in place instead of k sift-downs, and the rest
+    // heapified once: O(size + k log k).
+    void popBatch(std::size_t k, std::vector<Node>& out) {
+        k = k < count ? k : count;
+        if (count < BULK_POP_MIN || k * 4 < count) {
+            for (std::size_t i = 0; i < k; i++) {
+                out.push_back(pop());
+            }
+            return;
+        }
+
+        auto first = storage.begin() + OFFSET;
+        auto order = [this](const Node& a, const Node& b) { return less(a, b); };
+        if (k < count) {
+            std::nth_element(first, first + k, first + count, order);
+        }
+        std::sort(first, first + k, order);
+        for (std::size_t i = 0; i < k; i++) {
+            out.push_back(at(i));
+            forget(at(i).payload);
+        }
+        for (std::size_t i = k; i < count; i++) {
+            place(i - k, at(i));
+        }
+        count -= k;
+        storage.resize(count + OFFSET);
+        heapify();
+    }
+
+    // Addressable operations (TrackPositions only), O(log n)
+    bool contains(const Payload& payload) const {
+        static_assert(TrackPositions, "contains() needs TrackPositions");
+        std::size_t p = static_cast<std::size_t>(payload);
+        return p < positions.size() && positions[p] != NPOS;
+    }
+
+    const Node& find(const Payload& payload) const {
+        static_assert(TrackPositions, "find() needs TrackPositions");
+        return at(positions[static_cast<std::size_t>(payload)]);
+    }
+
+    void update(const Payload& payload, const Key& key) {
+        static_assert(TrackPositions, "update() needs TrackPositions");
+        std::size_t index = positions[static_cast<std::size_t>(payload)];
+        at(index).key = key;
+        restore(index);
+    }
+
+    void erase(const Payload& payload) {
+        static_assert(TrackPositions, "erase() needs TrackPositions");
+        std::size_t index = positions[static_cast<std::size_t>(payload)];
+        forget(payload);
+        count--;
+        if (index != count) {
+            place(index, at(count));
+            storage.pop_back();
+            restore(index);
+        } else {
+            storage.pop_back();
+        }
+    }
+
+    // Bottom-up (Floyd) heap construction, O(n)
+    void heapify() {
+        if (count < 2) {
+            return;
+        }
+        for (std::size_t i = (count - 2) / Arity + 1; i-- > 0;) {
+            siftDown(i);
+        }
+    }
+
+    // Recompute every key with fn(node) and restore the heap property
+    template <typename Fn>
+    void rekey(Fn fn) {
+        for (std::size_t i = 0; i < count; i++) {
+            fn(at(i));
+        }
+        heapify();
+    }
+
+    // State
+    bool empty() const { return count == 0; }
+    std::size_t size() const { return count; }
+    void reserve(std::size_t n) { storage.reserve(n + OFFSET); }
+    void clear() {
+        storage.resize(OFFSET);
+        count = 0;
+        positions.clear();
+    }
+
+    // Nodes in heap-array order
+    const Node& operator[](std::size_t i) const { return at(i); }
+
+    // Sift work so far (all zero without CountOps)
+    const HeapOpCounts& counts() const { return ops; }
+    void resetCounts() { ops = HeapOpCounts(); }
+};
+
+#endif // HEAP_H
@@ -0,0 +1,50 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// HDR-style histogram of non-negative integer latencies (time units).
+//
+// Values below 2^SUB_BUCKET_BITS are counted exactly; above that every power
+// of two is split into 2^(SUB_BUCKET_BITS - 1) linear sub-buckets, so any
+// reported percentile is within 1/128 (< 0.8%) of the true value. Recording is
+// O(1), memory grows only with the magnitude of the largest value (about 14 KB
+// for values up to 10^6, never more than 64 KB), and two histograms merge by
+// adding counts, so per-run or per-thread histograms can be combined.
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BUCKET_BITS = 8;
+    static constexpr size_t SUB_BUCKETS = size_t(1) << SUB_BUCKET_BITS;
+    static constexpr size_t HALF_BUCKETS = SUB_BUCKETS / 2;
+
+private:
+    std::vector<uint64_t> counts;
+    uint64_t total;
+    long long min_value;
+    long long max_value;
+    double sum;
+
+    static size_t indexOf(long long value);
+    static long long lowestValueAt(size_t index);
+    static long long highestValueAt(size_t index);
+
+public:
+    LatencyHistogram();
+
+    // Recording
+    void record(long long value, uint64_t count = 1);
+    void merge(const LatencyHistogram& other);
+    void reset();
+
+    // Queries
+    long long percentile(double p) const;   // p in [0, 100]
+    uint64_t countAbove(long long value) const;  // The bucket holding value counts whole
+    uint64_t getCount() const { return total; }
+    long long getMin() const { return total ? min_value : 0; }
+    long long getMax() const { return total ? max_value : 0; }
+    double getMean() const { return total ? sum / total : 0.0; }
+};
+
+#endif // LATENCY_HISTOGRAM_H
@@ -0,0 +1,100 @@
+#ifndef MULTI_CORE_SCHEDULER_H
+#define MULTI_CORE_SCHEDULER_H
+
+#include "ExecutionLog.h"
+#include "Process.h"
+#include "ProcessTable.h"
+#include "PriorityQueue.h"
+#include "Statistics.h"
+#include "WorkloadGenerator.h"
+#include <memory>
+#include <vector>
+
+// N-core simulation: one aging queue per simulated core, with idle cores
+// stealing work from busy ones.
+//
+// Time is divided into epochs of sync_interval units. Within an epoch every
+// core runs independently (non-preemptive, like Scheduler::run) on its own
+// queue and arrivals; cores only interact at epoch boundaries, where
+// arrivals for the next epoch are placed round-robin and idle cores steal.
+// Because of that, the epochs are simulated in parallel on host threads and
+// the result does not depend on how many host threads are used.
+//
+// Work stealing: at a sync point, each idle core (nothing running, nothing
+// queued) takes the most urgent half of the longest queue. Migrating costs
+// the thief migration_cost time units before it can dispatch.
+//
+// Processes run as single CPU bursts: I/O intervals (Process::getIoInterval())
+// are only simulated by the single-core scheduler.
+class MultiCoreScheduler {
+private:
+    // Padded to a cache line so cores simulated on different host threads
+    // do not false-share
+    struct alignas(64) Core {
+        int index;
+        PriorityQueue queue;
+        std::vector<uint32_t> pending;    // Arrivals placed on this core (table indices)
+        size_t next_pending;              // Cursor into pending
+        Process* running;
+        long long now;                    // Core-local clock
+        long long available_at;           // Stalled by migration until this time
+        long long busy_time;
+        long long last_completion;
+        std::vector<Process*> completed;  // Completions in the current epoch
+        std::vector<Process*> batch;      // Arrivals or stolen work moved together
+        ExecutionLog log;                 // This core's slices
+
+        Core(int index, double aging_factor);
+        void advance(ProcessTable& processes, long long epoch_end);
+        bool idle() const { return !running && queue.isEmpty() && next_pending == pending.size(); }
+    };
+
+    std::vector<std::unique_ptr<Core>> cores;
+    Statistics stats;
+    ProcessTable processes;
+    double aging_factor;
+    bool verbose;
+    long long sync_interval;    // Epoch length between synchronization points
+    long long migration_cost;   // Thief stall per steal
+    int host_threads;           // 0 = one per hardware thread (at most one per core)
+
+    // Helper methods
+    void placeArrivals(uint32_t& next_arrival, long long epoch_end, size_t& next_core);
+    void collectCompletions(uint32_t& completed);
+    void stealWork(long long now);
+    void simulateEpochs(int threads);
+
+public:
+    MultiCoreScheduler(int core_count = 4, double aging_factor = 0.1, bool verbose = true);
+
+    // Process management
+    void addProcess(const Process& process);
+    void addProcess(int id, int priority, long long arrival, int burst);
+    void generateRandomProcesses(int count, int max_priority = 10,
+                                 int max_arrival = 20, int max_burst = 10,
+                                 uint64_t seed = WorkloadSpec::DEFAULT_SEED);
+    void generateWorkload(const WorkloadSpec& spec);
+
+    // Simulation
+    void run();
+
+    // Configuration
+    void setVerbose(bool v) { verbose = v; }
+    void setSyncInterval(long long interval) { sync_interval = interval > 0 ? interval : 1; }
+    void setMigrationCost(long long cost) { migration_cost = cost > 0 ? cost : 0; }
+    void setHostThreads(int threads) { host_threads = threads > 0 ? threads : 0; }
+    void enableExecutionLog(bool enabled = true);
+
+    // Display
+    void displayStatistics() const;
+    void displayGanttChart() const;
+
+    // Results
+    int getCoreCount() const { return static_cast<int>(cores.size()); }
+    Statistics getStatistics() const { return stats; }
+    std::vector<const Process*> getCompletedProcesses() const;
+    const ProcessTable& getProcessTable() const { return processes; }
+    ExecutionLog getExecutionLog() const;    // All cores, in time order
+};
+
+#endif // MULTI_CORE_SCHEDULER_H
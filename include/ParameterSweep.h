@@ -0,0 +1,75 @@
+#ifndef PARAMETER_SWEEP_H
+#define PARAMETER_SWEEP_H
+
+#include "PriorityQueue.h"
+#include "Statistics.h"
+#include "Trace.h"
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// Scheduling policy of one sweep axis
+struct SweepPolicy {
+    std::string name;
+    bool preemptive = false;
+    int time_quantum = 0;
+    AgingMode aging_mode = AgingMode::Lazy;
+    QueueBackend backend = QueueBackend::Heap;
+
+    // "nonpreemptive", "preemptive" or "preemptive-qN" (quantum N)
+    static bool parse(std::string text, SweepPolicy& policy);
+};
+
+struct SweepResult {
+    std::string workload;
+    std::string policy;
+    double aging_factor;
+    Statistics stats;
+};
+
+// Runs every combination of workload x policy x aging factor on a pool of
+// threads.
+//
+// Workloads are stored once, sorted by arrival, and streamed read-only into
+// each run, so a grid point costs no copy of its workload beyond the
+// processes in flight. Every run is an independent single-core Scheduler and
+// results are returned in grid order (workload, then policy, then factor),
+// so the output is the same for any thread count.
+class ParameterSweep {
+private:
+    struct Workload {
+        std::string name;
+        std::vector<TraceRecord> records;
+    };
+
+    std::vector<Workload> workloads;
+    std::vector<SweepPolicy> policies;
+    std::vector<double> factors;
+    int threads;
+
+    SweepResult runPoint(size_t index) const;
+
+public:
+    // threads = 0 uses one per hardware thread
+    explicit ParameterSweep(int threads = 0);
+
+    // Grid axes
+    void addWorkload(const std::string& name, std::vector<TraceRecord> records);
+    void addPolicy(const SweepPolicy& policy) { policies.push_back(policy); }
+    void addAgingFactor(double factor) { factors.push_back(factor); }
+    void setThreads(int count);
+
+    size_t size() const { return workloads.size() * policies.size() * factors.size(); }
+
+    std::vector<SweepResult> run() const;
+
+    // "0,0.05,0.1" or an inclusive range "start:stop:step"
+    static bool parseFactors(const std::string& text, std::vector<double>& factors);
+
+    // Results table, one row per grid point
+    static void writeText(std::ostream& out, const std::vector<SweepResult>& results);
+    static void writeCsv(std::ostream& out, const std::vector<SweepResult>& results);
+    static void writeJson(std::ostream& out, const std::vector<SweepResult>& results);
+};
+
+#endif // PARAMETER_SWEEP_H
@@ -1,55 +1,283 @@
 #ifndef PRIORITY_QUEUE_H
 #define PRIORITY_QUEUE_H
 
+#include "AgingPolicy.h"
 #include "Process.h"
+#include "Heap.h"
+#include "BucketQueue.h"
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
 #include <vector>
 
-class PriorityQueue {
+// Hot-path instrumentation: build with -DPQ_INSTRUMENT=1 (make instrumented)
+// to count the heap work of every operation. Off by default, and then the
+// counting compiles away entirely.
+#ifndef PQ_INSTRUMENT
+#define PQ_INSTRUMENT 0
+#endif
+
+constexpr bool QUEUE_INSTRUMENTED = PQ_INSTRUMENT != 0;
+
+// Heap work per queue operation, and time spent aging (PQ_INSTRUMENT builds;
+// all zero otherwise). Counts cover the heap backend; the bucket backend
+// only counts calls.
+struct QueueOpStats {
+    struct Op {
+        uint64_t calls = 0;
+        uint64_t comparisons = 0;
+        uint64_t swaps = 0;
+        uint64_t levels = 0;
+    };
+    Op insert;
+    Op extract_min;
+    Op insert_batch;                // insertBatch(), one call per batch
+    Op extract_top_k;               // extractTopK(), one call per batch
+    Op rebuild;                     // rebuildHeap(), including eager aging
+    uint64_t aging_calls = 0;       // applyAging()
+    uint64_t aging_ns = 0;
+};
+
+// How the queue keeps up with aging.
+//  Eager: every applyAging() recomputes all effective priorities and rebuilds
+//         the heap (O(n) per tick).
+//  Lazy:  entries are ordered by the policy's time-invariant key, for
+//         linear aging base_priority + ready_origin * aging_factor
+//         (ready_origin = arrival + executed + blocked time only moves
+//         while a process runs or waits on I/O, never while it is queued).
+//         Under linear aging every waiting process gains priority at the
+//         same rate, so in exact arithmetic this key orders the queue like
+//         the effective priority and applyAging() is O(1). In floating
+//         point the key and base - waited * aging_factor round
+//         differently, so near-ties can leave in another order than in
+//         Eager mode; the modes agree exactly when aging_factor is
+//         binary-exact (e.g. 0.25, 0.5) or with FIXED_POINT. Effective
+//         priorities are only computed when observed. Policies whose
+//         order changes with time (not ORDER_INVARIANT) are always Eager;
+//         FIXED_POINT policies are always Lazy.
+enum class AgingMode {
+    Eager,
+    Lazy
+};
+
+// Data structure behind the queue.
+//  Heap:   4-ary heap, O(log n) insert and extract.
+//  Bucket: one FIFO per base priority plus a bitmap of non-empty levels,
+//          O(1) insert and O(L) extract for L distinct base priorities.
+//          Always orders by the lazy aging key; since aging is uniform
+//          within a level, aging never moves entries between levels.
+//          ORDER_INVARIANT policies only; others always use the heap.
+//          The order is identical to the heap in Lazy mode. In Eager mode
+//          it is the Lazy order, which differs from the heap's only where
+//          floating-point rounding of the effective priority does.
+enum class QueueBackend {
+    Heap,
+    Bucket
+};
+
+// What a queue at capacity does with one more arrival (offer()).
+//  Reject:       the arrival is refused.
+//  EvictLowest:  whichever of the queued processes and the arrival has the
+//                lowest effective priority is shed. The queue then keeps a
+//                second, max-ordered heap over the same entries, so the
+//                victim is found in O(1) and removed in O(log n).
+//  Backpressure: the arrival is refused like Reject, but the producer keeps
+//                it and offers it again once an entry has left (the
+//                scheduler holds back its arrivals meanwhile).
+enum class OverflowPolicy {
+    Reject,
+    EvictLowest,
+    Backpressure
+};
+
+// Priority queue with aging under a compile-time policy (AgingPolicy.h).
+// Instantiated in PriorityQueue.cpp for the policies there.
+template <typename Policy>
+class BasicPriorityQueue {
+public:
+    using Aging = Policy;
+    using Key = typename Policy::Key;
+    static constexpr unsigned HEAP_ARITY = 4;  // 4 x 16-byte nodes = one cache line
+    static constexpr bool INSTRUMENTED = QUEUE_INSTRUMENTED;
+    // Eager aging recomputes with the vector kernel (AgingKernel.h)
+    static constexpr bool BULK_AGING = Policy::PIECEWISE_LINEAR;
+    // Integer keys with a FIFO sequence packed in: distinct, one compare
+    static constexpr bool FIXED_POINT = Policy::FIXED_POINT;
+
 private:
-    std::vector<Process*> heap;     // Min-heap array (lower priority value = higher priority)
+    // Orders heap nodes by their inline key; only exact ties look at the
+    // processes themselves
+    struct EntryOrder {
+        const BasicPriorityQueue* queue;
+        template <typename Node>
+        bool operator()(const Node& a, const Node& b) const {
+            if constexpr (FIXED_POINT) {
+                return a.key < b.key;
+            }
+            if (a.key != b.key) {
+                return a.key < b.key;
+            }
+            return queue->breaksTie(a.payload, b.payload);
+        }
+    };
+
+    // The reverse order: the least urgent entry on top
+    struct ShedOrder {
+        EntryOrder order;
+        template <typename Node>
+        bool operator()(const Node& a, const Node& b) const {
+            return order(b, a);
+        }
+    };
+
+    using EntryHeap = Heap<Key, uint32_t, HEAP_ARITY, EntryOrder, true, INSTRUMENTED>;
+    using EntryBuckets = BucketQueue<Key, uint32_t, EntryOrder>;
+    using ShedHeap = Heap<Key, uint32_t, HEAP_ARITY, ShedOrder, true>;
+
+    static constexpr Key LOWEST_KEY = std::numeric_limits<Key>::has_infinity
+                                          ? -std::numeric_limits<Key>::infinity()
+                                          : std::numeric_limits<Key>::lowest();
+
+    EntryHeap heap;                 // Keys inline, payload = slot index
+    EntryBuckets buckets;           // Same entries when backend == Bucket
+    QueueBackend backend;
+    // Bounded mode: capacity 0 = unbounded. With EvictLowest, shed_heap
+    // holds every queued entry with the same key as the main backend.
+    size_t capacity;
+    OverflowPolicy overflow;
+    ShedHeap shed_heap;
+    std::vector<Process*> slots;    // Slot index -> process
+    std::vector<long long> slot_waited;  // Waiting time accrued before the current stay
+    std::vector<uint32_t> free_slots;
+    std::vector<typename EntryHeap::Node> batch_nodes;  // Scratch for batch operations
+    // Eager mode with BULK_AGING: per-slot copies of what aging reads, so
+    // applyAging() runs the vector kernel over three arrays instead of
+    // visiting every Process. origin = getReadyOrigin() (+infinity when
+    // the slot is free); heap keys are slot_effective. Empty otherwise.
+    std::vector<double> slot_origin;
+    std::vector<double> slot_base;
+    std::vector<double> slot_effective;
+    // FIXED_POINT: insertion order of each slot's entry, packed into its key
+    std::vector<uint64_t> slot_sequence;
+    uint64_t next_sequence;
+    // Process id -> slot (ids unique while queued). Built on the first
+    // addressable call, then kept in sync, so plain insert/extract users
+    // never pay for it.
+    mutable std::unordered_map<int, uint32_t> slot_of;
+    mutable bool ids_indexed;
     double aging_factor;            // Aging rate (default 0.1)
-    int current_time;               // Simulation time
-    int aging_events;               // Count of priority adjustments
+    AgingMode mode;                 // Eager recompute or lazy aging keys
+    long long current_time;         // Simulation time
+    long long aging_events;         // Count of priority adjustments
+    // Largest aging key queued, for the least urgent effective priority.
+    // Raised on insert; a removal at the maximum only marks it stale and
+    // the next query rescans, so tracking costs O(1) per operation.
+    mutable Key max_key;
+    mutable bool max_key_stale;
+    QueueOpStats op_stats;          // INSTRUMENTED only
+
+    // Ordering helpers
+    Key agingKey(const Process* process) const;
+    Key heapKey(uint32_t slot) const;
+    void checkKey(int base_priority, const Process* process) const;
+    bool breaksTie(uint32_t a, uint32_t b) const;
 
-    // Heap helper methods
-    int parent(int i) const { return (i - 1) / 2; }
-    int leftChild(int i) const { return 2 * i + 1; }
-    int rightChild(int i) const { return 2 * i + 2; }
+    // Backend dispatch
+    void pushEntry(uint32_t slot);
+    uint32_t topEntry() const;
+    uint32_t popEntry();
+    void eraseEntry(uint32_t slot);
+    void updateEntry(uint32_t slot);
+    template <typename Fn>
+    void forEachEntry(Fn fn) const;
 
-    // Heap operations
-    void heapifyUp(int index);
-    void heapifyDown(int index);
-    void swap(int i, int j);
+    // Lazy mode helpers
+    void observe(Process* process) const;
+    void countAgingEvents(Process* process, long long waited_before);
 
-    // Comparison based on effective priority
-    bool hasHigherPriority(int i, int j) const;
+    // Slot management
+    void reserveSequences(Process* const* processes, size_t count);
+    uint32_t acquireSlot(Process* process, long long waited_before);
+    Process* releaseSlot(uint32_t slot);
+    void indexIds() const;
+    bool bulkAging() const { return BULK_AGING && mode == AgingMode::Eager; }
+    bool tracksLowest() const { return capacity > 0 && overflow == OverflowPolicy::EvictLowest; }
+    void renumberSequences();
+    // The mode the policy allows in place of m
+    static AgingMode supportedMode(AgingMode m) {
+        return FIXED_POINT ? AgingMode::Lazy : Policy::ORDER_INVARIANT ? m : AgingMode::Eager;
+    }
+    void syncBulkArrays();
 
 public:
     // Constructor & Destructor
-    PriorityQueue(double aging_factor = 0.1);
-    ~PriorityQueue();
+    BasicPriorityQueue(double aging_factor = 0.1, AgingMode mode = AgingMode::Lazy,
+                       QueueBackend backend = QueueBackend::Heap);
+    ~BasicPriorityQueue();
+
+    // The heap comparator refers back to this queue
+    BasicPriorityQueue(const BasicPriorityQueue&) = delete;
+    BasicPriorityQueue& operator=(const BasicPriorityQueue&) = delete;
 
     // Core operations
     void insert(Process* process);
     Process* extractMin();          // Get highest priority (lowest value)
     Process* peek() const;
 
+    // Batch operations: the same order as one insert()/extractMin() at a
+    // time, cheaper for large batches (heap backend)
+    void insertBatch(Process* const* processes, size_t count);
+    void insertBatch(const std::vector<Process*>& processes) { insertBatch(processes.data(), processes.size()); }
+    // Appends up to k processes to out, most urgent first; returns how many
+    size_t extractTopK(size_t k, std::vector<Process*>& out);
+
+    // Admission control: insert() under the capacity. Returns the process
+    // that did not make it, or nullptr when the arrival was queued and
+    // nothing was shed: the arrival itself (refused, or the least urgent
+    // under EvictLowest) or the evicted entry. insert() and insertBatch()
+    // bypass the capacity (requeues must not be lost). In Eager mode apply
+    // aging up to the current time first, so eviction compares current
+    // effective priorities.
+    Process* offer(Process* process);
+
+    // Addressable operations by process id, O(log n) (O(1) with Bucket)
+    bool contains(int id) const;
+    Process* erase(int id);                             // Remove without running (nullptr if absent)
+    bool updatePriority(int id, int new_base_priority); // Raise or lower base priority in place
+
     // Aging mechanism
-    void applyAging(int current_time);
-    void updateAllPriorities(int current_time);
+    void applyAging(long long current_time);
+    void updateAllPriorities(long long current_time);
     void rebuildHeap();
 
     // Queue state
-    bool isEmpty() const { return heap.empty(); }
-    int size() const { return heap.size(); }
+    bool isEmpty() const { return size() == 0; }
+    int size() const { return static_cast<int>(backend == QueueBackend::Heap ? heap.size() : buckets.size()); }
+    bool isFull() const { return capacity > 0 && static_cast<size_t>(size()) >= capacity; }
+
+    // Most and least urgent effective priority queued at time (0 when empty)
+    void getEffectivePriorityRange(long long time, double& lowest, double& highest) const;
 
     // Statistics
-    int getAgingEvents() const { return aging_events; }
+    long long getAgingEvents() const { return aging_events; }
     void resetAgingEvents() { aging_events = 0; }
+    const QueueOpStats& getOpStats() const { return op_stats; }
+    void resetOpStats() { op_stats = QueueOpStats(); }
 
     // Setters
-    void setCurrentTime(int time) { current_time = time; }
-    void setAgingFactor(double factor) { aging_factor = factor; }
+    void setCurrentTime(long long time) { current_time = time; }
+    void setAgingFactor(double factor) { aging_factor = factor; max_key_stale = true; rebuildHeap(); }
+    void setAgingMode(AgingMode m);
+    void setBackend(QueueBackend b);
+    // Bounds the queue (0 = unbounded); entries already queued all stay
+    void setCapacity(size_t max_entries, OverflowPolicy policy = OverflowPolicy::Reject);
+
+    // Getters
+    double getAgingFactor() const { return aging_factor; }
+    AgingMode getAgingMode() const { return mode; }
+    QueueBackend getBackend() const { return backend; }
+    size_t getCapacity() const { return capacity; }
+    OverflowPolicy getOverflowPolicy() const { return overflow; }
 
     // Visualization
     std::vector<Process*> getQueueSnapshot() const;
@@ -57,4 +285,6 @@ public:
     void displayDetailed() const;
 };
 
+using PriorityQueue = BasicPriorityQueue<LinearAging>;
+
 #endif // PRIORITY_QUEUE_H
@@ -1,47 +1,92 @@
 #ifndef PROCESS_H
 #define PROCESS_H
 
+#include "AgingPolicy.h"
 #include <string>
+#include <algorithm>
 
+// Fields are grouped by how the scheduler touches them: the hot block is read
+// on every arrival, dispatch and queue operation; the cold block is only
+// written at first dispatch/completion and read for reporting.
 class Process {
 private:
-    int id;                      // Unique identifier
+    // Hot: scheduling state (first 56 bytes)
+    long long arrival_time;      // When process arrives
     int base_priority;           // Original priority (1-10, lower is higher)
-    int arrival_time;            // When process arrives
     int burst_time;              // Execution time needed
     int remaining_time;          // Remaining execution time
-    int waiting_time;            // Time spent waiting
-    int start_time;              // When execution started (-1 if not started)
-    int completion_time;         // When finished (-1 if not finished)
+    int id;                      // Unique identifier (also the final tie-break)
+    long long waiting_time;      // Time spent waiting
     double effective_priority;   // Current priority after aging
+    int io_interval;             // CPU time between I/O requests (0 = CPU-bound)
+    int io_time;                 // Length of each I/O burst
+    long long blocked_time;      // Time spent in I/O so far
+
+    // Cold: reporting
+    long long start_time;        // When execution started (-1 if not started)
+    long long completion_time;   // When finished (-1 if not finished)
 
 public:
-    // Constructor
-    Process(int id, int priority, int arrival, int burst);
+    // Constructor. An I/O-bound process alternates CPU and I/O bursts: it
+    // blocks for io_time after every io_interval units of CPU, except at
+    // the end of its last CPU burst.
+    Process(int id, int priority, long long arrival, int burst, int io_interval = 0, int io_time = 0);
 
     // Getters
     int getId() const { return id; }
     int getBasePriority() const { return base_priority; }
     double getEffectivePriority() const { return effective_priority; }
-    int getArrivalTime() const { return arrival_time; }
+    long long getArrivalTime() const { return arrival_time; }
     int getBurstTime() const { return burst_time; }
     int getRemainingTime() const { return remaining_time; }
-    int getWaitingTime() const { return waiting_time; }
-    int getStartTime() const { return start_time; }
-    int getCompletionTime() const { return completion_time; }
+    int getExecutedTime() const { return burst_time - remaining_time; }
+    long long getWaitingTime() const { return waiting_time; }
+    long long getStartTime() const { return start_time; }
+    long long getCompletionTime() const { return completion_time; }
+    int getIoInterval() const { return io_interval; }
+    int getIoTime() const { return io_time; }
+    long long getBlockedTime() const { return blocked_time; }
+    // Since when the process has been ready: waiting accrues from here, so
+    // time on the CPU and in I/O does not count
+    long long getReadyOrigin() const { return arrival_time + getExecutedTime() + blocked_time; }
+    // CPU time until the current CPU burst ends (I/O request or completion)
+    int getCpuUntilIo() const {
+        return io_interval > 0 ? std::min(remaining_time, io_interval - getExecutedTime() % io_interval)
+                               : remaining_time;
+    }
 
     // Setters
-    void setStartTime(int time) { start_time = time; }
-    void setCompletionTime(int time) { completion_time = time; }
-    void setWaitingTime(int time) { waiting_time = time; }
+    void setBasePriority(int priority) { base_priority = priority; }
+    void setStartTime(long long time) { start_time = time; }
+    void setCompletionTime(long long time) { completion_time = time; }
+    void setWaitingTime(long long time) { waiting_time = time; }
     void decrementRemainingTime() { if (remaining_time > 0) remaining_time--; }
+    void execute(int time_units) { remaining_time -= std::min(time_units, remaining_time); }
+    // Starts an I/O burst; its time is counted as blocked right away
+    void beginIo() { blocked_time += io_time; }
 
-    // Priority calculation
-    void updateEffectivePriority(int current_time, double aging_factor);
+    // Priority calculation under an aging policy (see AgingPolicy.h)
+    template <typename Policy = LinearAging>
+    void updateEffectivePriority(long long current_time, double aging_factor) {
+        if (completion_time != -1) {
+            return;
+        }
+        // Time in the system minus time already spent on the CPU and in I/O.
+        // This stays frozen while the process runs or is blocked and resumes
+        // when it is preempted or wakes up.
+        waiting_time = std::max(0LL, current_time - getReadyOrigin());
+        effective_priority = Policy::effective(base_priority, waiting_time, aging_factor);
+    }
+    // Aging events between waited_before and the waiting time recorded by
+    // the last updateEffectivePriority()
+    template <typename Policy = LinearAging>
+    long long agingEventsSince(long long waited_before, double aging_factor) const {
+        return Policy::agingEvents(base_priority, waited_before, waiting_time, aging_factor);
+    }
 
     // Time calculations
-    int getTurnaroundTime() const;
-    int getResponseTime() const;
+    long long getTurnaroundTime() const;
+    long long getResponseTime() const;
 
     // Display
     std::string toString() const;
@@ -50,6 +95,11 @@ public:
     // Status check
     bool isCompleted() const { return remaining_time == 0; }
     bool hasStarted() const { return start_time != -1; }
+    // Just finished a CPU burst with more to come (only meaningful right
+    // after execution)
+    bool needsIo() const {
+        return io_interval > 0 && remaining_time > 0 && getExecutedTime() % io_interval == 0;
+    }
 };
 
 #endif // PROCESS_H
@@ -0,0 +1,48 @@
+#ifndef PROCESS_TABLE_H
+#define PROCESS_TABLE_H
+
+#include "Process.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Pool arena owning every Process of a simulation, addressed by 32-bit index.
+//
+// Records live in fixed-size chunks that are allocated once and never move,
+// so a Process* handed to the queue stays valid while more records are
+// added. Loading N processes costs N / CHUNK_SIZE allocations instead of N.
+class ProcessTable {
+public:
+    static constexpr uint32_t CHUNK_BITS = 16;
+    static constexpr uint32_t CHUNK_SIZE = 1u << CHUNK_BITS;  // 65536 records
+    static constexpr uint32_t CHUNK_MASK = CHUNK_SIZE - 1;
+
+private:
+    std::vector<std::unique_ptr<std::vector<Process>>> chunks;
+    uint32_t count;
+
+public:
+    ProcessTable();
+
+    // Records
+    uint32_t add(const Process& process);
+    uint32_t add(int id, int priority, long long arrival, int burst);
+    Process& operator[](uint32_t index) { return (*chunks[index >> CHUNK_BITS])[index & CHUNK_MASK]; }
+    const Process& operator[](uint32_t index) const { return (*chunks[index >> CHUNK_BITS])[index & CHUNK_MASK]; }
+
+    // Reorders records by arrival time (stable). No-op when already sorted,
+    // which is the common case for generated and trace workloads. Invalidates
+    // indices and pointers, so call it before scheduling starts.
+    void sortByArrival();
+
+    // State
+    uint32_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    void clear();
+
+    // Bytes held by the arena (excluding the table object itself)
+    size_t memoryUsage() const;
+};
+
+#endif // PROCESS_TABLE_H
@@ -1,46 +1,116 @@
 #ifndef SCHEDULER_H
 #define SCHEDULER_H
 
+#include "ExecutionLog.h"
 #include "Process.h"
+#include "ProcessTable.h"
 #include "PriorityQueue.h"
 #include "Statistics.h"
+#include "Telemetry.h"
+#include "TimingWheel.h"
+#include "Trace.h"
 #include "Visualizer.h"
+#include "WorkloadGenerator.h"
 #include <vector>
 #include <string>
 
-class Scheduler {
+class FrameRenderer;
+
+// Single-core scheduler under a compile-time aging policy (AgingPolicy.h);
+// the queue is specialized on the same policy. Instantiated in Scheduler.cpp
+// for the policies there.
+template <typename Policy>
+class BasicScheduler {
 private:
-    PriorityQueue queue;
+    BasicPriorityQueue<Policy> queue;
     Statistics stats;
-    std::vector<Process*> all_processes;
-    std::vector<Process*> completed_processes;
-    int current_time;
+    ProcessTable processes;     // Arena owning all processes, sorted by arrival at run start
+    long long current_time;
+    uint32_t next_arrival;      // Cursor into processes (sorted by arrival)
+    std::vector<Process*> arrival_batch;    // Arrivals (and wakeups) admitted together
+    TimingWheel<Process*> blocked;          // Processes in I/O, keyed by wake-up time
     bool verbose;               // Enable detailed output
     int visualization_delay;    // Delay in milliseconds for visualization
+    FrameRenderer* renderer;    // Live view (not owned), nullptr = none
+    bool preemptive;            // Preempt on higher-priority arrival / quantum expiry
+    int time_quantum;           // Max slice length in preemptive mode (0 = unlimited)
+
+    // Streaming workload: arrivals are pulled from the source as simulated
+    // time reaches them and completed records are recycled, so the table
+    // only ever holds the processes in flight
+    WorkloadSource* source;
+    std::vector<Process*> free_records;
+    long long streamed;
+
+    Telemetry telemetry;        // Periodic samples (off unless enabled)
+    ExecutionLog execution_log; // Execution slices (off unless enabled)
 
     // Helper methods
-    void addArrivedProcesses();
-    void cleanup();
+    bool arrivalsPending();
+    long long nextArrivalTime();
+    Process* admitFromSource(const TraceRecord& record);
+    Process* takeArrival();
+    bool addArrivedProcesses();
+    bool offerArrivals();
+    bool producerBlocked() const;
+    Process* takeWakeup();
+    void blockForIo(Process* process);
+    long long nextEventTime();
+    Process* dispatch(Process* preempted);
+    bool preemptIfNeeded(Process* running, int slice_used, bool arrivals);
+    bool beginRun();
+    void completeProcess(Process* process);
+    void finishRun();
+    void publishFrame(const Process* running, long long until, bool final_frame = false);
+    void pace(long long time_units);
 
 public:
     // Constructor & Destructor
-    Scheduler(double aging_factor = 0.1, bool verbose = true);
-    ~Scheduler();
+    BasicScheduler(double aging_factor = 0.1, bool verbose = true);
+    ~BasicScheduler();
 
     // Process management
-    void addProcess(Process* process);
-    void addProcess(int id, int priority, int arrival, int burst);
+    void addProcess(const Process& process);
+    void addProcess(int id, int priority, long long arrival, int burst);
     void generateRandomProcesses(int count, int max_priority = 10,
-                                 int max_arrival = 20, int max_burst = 10);
+                                 int max_arrival = 20, int max_burst = 10,
+                                 uint64_t seed = WorkloadSpec::DEFAULT_SEED);
+    void generateWorkload(const WorkloadSpec& spec);
 
-    // Simulation
-    void run();                 // Non-preemptive simulation
-    void runWithVisualization(int delay_ms = 500);
+    // Streams the workload from a trace reader or generator during run()
+    // instead of the process table (nullptr to go back). Per-process results
+    // are not kept in this mode: getCompletedProcesses() is empty (the
+    // execution log still works when enabled).
+    void setWorkloadSource(WorkloadSource* workload) { source = workload; }
+
+    // Simulation. Processes with I/O (Process::getIoInterval() > 0) block
+    // after each CPU burst and wait in a timing wheel until their I/O ends;
+    // then they rejoin the ready queue with the waiting they had before.
+    void run();                 // Event-driven simulation
+    void runTickBased();        // Reference engine: advances one time unit per step
+    void runWithVisualization(int delay_ms = 500);   // Live view, paced per time unit
 
     // Configuration
     void setVerbose(bool v) { verbose = v; }
     void setVisualizationDelay(int ms) { visualization_delay = ms; }
+    // Publishes snapshots to a live view during runs (nullptr to stop)
+    void setRenderer(FrameRenderer* live) { renderer = live; }
     void setAgingFactor(double factor) { queue.setAgingFactor(factor); }
+    void setAgingMode(AgingMode mode) { queue.setAgingMode(mode); }
+    void setQueueBackend(QueueBackend backend) { queue.setBackend(backend); }
+    void setPreemptive(bool enabled, int quantum = 0) { preemptive = enabled; time_quantum = quantum; }
+    // Bounds the ready queue (0 = unbounded); arrivals beyond it are
+    // rejected, shed or held back with the producer as the policy says
+    void setQueueCapacity(size_t capacity, OverflowPolicy policy = OverflowPolicy::Reject) {
+        queue.setCapacity(capacity, policy);
+    }
+    // Samples the queue and CPU every interval time units into a ring of
+    // capacity samples (interval 0 disables)
+    void enableTelemetry(long long interval, size_t capacity = Telemetry::DEFAULT_CAPACITY) {
+        telemetry = Telemetry(interval, capacity);
+    }
+    // Records every execution slice (needed by the Gantt chart)
+    void enableExecutionLog(bool enabled = true) { execution_log.setEnabled(enabled); }
 
     // Display
     void displayProcessList() const;
@@ -49,7 +119,13 @@ public:
 
     // Results
     Statistics getStatistics() const { return stats; }
-    const std::vector<Process*>& getCompletedProcesses() const { return completed_processes; }
+    const Telemetry& getTelemetry() const { return telemetry; }
+    const ExecutionLog& getExecutionLog() const { return execution_log; }
+    const QueueOpStats& getQueueOpStats() const { return queue.getOpStats(); }
+    std::vector<const Process*> getCompletedProcesses() const;
+    const ProcessTable& getProcessTable() const { return processes; }
 };
 
+using Scheduler = BasicScheduler<LinearAging>;
+
 #endif // SCHEDULER_H
@@ -1,41 +1,89 @@
 #ifndef STATISTICS_H
 #define STATISTICS_H
 
+#include "LatencyHistogram.h"
 #include "Process.h"
 #include <vector>
 #include <map>
 #include <string>
 
+// Latency distributions of one group of processes
+struct LatencyBreakdown {
+    LatencyHistogram waiting;
+    LatencyHistogram response;
+    LatencyHistogram turnaround;
+
+    void record(const Process* process);
+    void merge(const LatencyBreakdown& other);
+};
+
 class Statistics {
 private:
-    int total_processes;
-    int completed_processes;
+    long long total_processes;
+    long long completed_processes;
     double total_waiting_time;
     double total_turnaround_time;
     double total_response_time;
-    int aging_events;
-    int max_waiting_time;
-    int total_burst_time;
-    int total_execution_time;
+    long long aging_events;
+    long long max_waiting_time;
+    long long total_burst_time;
+    long long total_execution_time;
+    long long preemptions;
+    long long migrations;
+    long long rejected;             // Arrivals refused by a full queue
+    long long shed;                 // Queued processes evicted for an arrival
+    std::vector<long long> core_busy_time;  // Per simulated core (multi-core runs only)
     std::map<int, int> priority_changes;  // Track changes per process
 
+    // Distributions (bounded memory, mergeable)
+    LatencyBreakdown latency;
+    std::map<int, LatencyBreakdown> by_priority;    // Keyed by base priority
+    double slowdown_sum;            // Slowdown = turnaround / (burst + I/O)
+    double slowdown_squares;
+    long long starvation_threshold; // 0 = 10x the mean burst time
+
 public:
     Statistics();
 
     // Recording
     void recordProcess(const Process* process);
     void recordAgingEvent(int process_id = -1);
-    void setTotalProcesses(int count) { total_processes = count; }
-    void setTotalExecutionTime(int time) { total_execution_time = time; }
+    void recordAgingEvents(long long count) { aging_events += count; }
+    void recordPreemption() { preemptions++; }
+    void recordMigration() { migrations++; }
+    void recordRejection() { rejected++; }
+    void recordShed() { shed++; }
+    void setCoreBusyTime(int core, long long busy_time);
+    void setTotalProcesses(long long count) { total_processes = count; }
+    void setTotalExecutionTime(long long time) { total_execution_time = time; }
+    void setStarvationThreshold(long long wait) { starvation_threshold = wait; }
+
+    // Combines another run (or another thread's share of a run): counts,
+    // sums, busy times and histograms add up, maxima are kept
+    void merge(const Statistics& other);
 
     // Calculations
     double getAverageWaitingTime() const;
     double getAverageTurnaroundTime() const;
     double getAverageResponseTime() const;
     double getCpuUtilization() const;
-    int getTotalAgingEvents() const { return aging_events; }
-    int getMaxWaitingTime() const { return max_waiting_time; }
-    int getCompletedProcesses() const { return completed_processes; }
+    long long getTotalAgingEvents() const { return aging_events; }
+    long long getMaxWaitingTime() const { return max_waiting_time; }
+    long long getPreemptions() const { return preemptions; }
+    long long getMigrations() const { return migrations; }
+    long long getRejected() const { return rejected; }
+    long long getShed() const { return shed; }
+    int getCoreCount() const { return core_busy_time.empty() ? 1 : static_cast<int>(core_busy_time.size()); }
+    double getCoreUtilization(int core) const;
+    long long getCompletedProcesses() const { return completed_processes; }
+
+    // Distributions
+    const LatencyBreakdown& getLatency() const { return latency; }
+    const std::map<int, LatencyBreakdown>& getLatencyByPriority() const { return by_priority; }
+    long long getWaitingPercentile(double p) const { return latency.waiting.percentile(p); }
+    long long getStarvationThreshold() const;
+    double getStarvationRate() const;   // Share of processes waiting beyond the threshold
+    double getFairnessIndex() const;    // Jain's index of slowdowns: 1 = equal, 1/n = worst
 
     // Reset
     void reset();
@@ -43,6 +91,11 @@ public:
     // Display
     void display() const;
     std::string generateReport() const;
+
+    // Machine-readable output (one object / one row per run)
+    std::string toJson() const;
+    static std::string csvHeader();
+    std::string toCsvRow() const;
 };
 
 #endif // STATISTICS_H
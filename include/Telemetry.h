@@ -0,0 +1,129 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+// State of the scheduler at one sampling instant. Queue figures describe the
+// ready queue (the running process excluded); interval counters cover the
+// time since the previous sample.
+struct TelemetrySample {
+    long long time;
+    uint32_t queue_length;
+    double min_priority;        // Most urgent effective priority queued
+    double max_priority;        // Least urgent effective priority queued
+    long long aging_events;     // Credited during the interval
+    long long busy_ticks;       // CPU busy time during the interval
+    bool cpu_busy;              // CPU state from this instant on
+};
+
+// Periodic scheduler samples in a fixed-capacity ring buffer.
+//
+// The scheduler reports each span of time with unchanged state; a sample is
+// taken at every multiple of the interval, so the event-driven and tick-based
+// engines record identical samples. Each sample is O(1) (the queue tracks its
+// key range) and memory is fixed at construction: once full the oldest
+// samples are overwritten and counted as dropped, so it can stay on for runs
+// of any length. Disabled (interval 0, no buffer) by default.
+class Telemetry {
+private:
+    std::vector<TelemetrySample> ring;
+    size_t head;                // Oldest sample
+    size_t count;
+    long long dropped;
+
+    long long interval;
+    long long next_sample;      // Next sampling instant
+    long long interval_busy;    // Busy ticks since the previous sample
+    long long last_aging_events;
+
+    void push(const TelemetrySample& sample);
+    template <typename Queue>
+    void sampleSpan(long long from, long long to, bool busy, const Queue& queue);
+
+public:
+    static constexpr long long DEFAULT_INTERVAL = 100;
+    static constexpr size_t DEFAULT_CAPACITY = 4096;
+
+    explicit Telemetry(long long interval = 0, size_t capacity = DEFAULT_CAPACITY);
+
+    bool isEnabled() const { return interval > 0; }
+
+    // Clears the samples at the start of a run on queue (a BasicPriorityQueue
+    // under any aging policy)
+    template <typename Queue>
+    void begin(const Queue& queue) {
+        head = 0;
+        count = 0;
+        dropped = 0;
+        next_sample = 0;
+        interval_busy = 0;
+        last_aging_events = queue.getAgingEvents();
+    }
+
+    // Reports [from, to) with the CPU busy or idle and the queue unchanged
+    // (as it stands now, after any dispatch at from)
+    template <typename Queue>
+    void advance(long long from, long long to, bool busy, const Queue& queue) {
+        if (interval > 0) {
+            if (to > next_sample) {
+                sampleSpan(from, to, busy, queue);
+            } else if (busy) {
+                interval_busy += to - from;
+            }
+        }
+    }
+
+    // Samples oldest first
+    std::vector<TelemetrySample> samples() const;
+    size_t size() const { return count; }
+    size_t capacity() const { return ring.size(); }
+    long long getDropped() const { return dropped; }
+    long long getInterval() const { return interval; }
+
+    void writeCsv(std::ostream& out) const;
+};
+
+template <typename Queue>
+void Telemetry::sampleSpan(long long from, long long to, bool busy, const Queue& queue) {
+    long long cursor = from;
+
+    // A long span (an idle gap, a long burst) would overwrite the whole ring
+    // several times: skip straight to the samples that survive
+    long long due = (to - 1 - next_sample) / interval + 1;
+    long long keep = static_cast<long long>(ring.size());
+    if (due > keep) {
+        next_sample += (due - keep) * interval;
+        cursor = next_sample - interval;
+        dropped += due - keep;
+        interval_busy = 0;
+        last_aging_events = queue.getAgingEvents();
+    }
+
+    uint32_t length = static_cast<uint32_t>(queue.size());
+    long long events = queue.getAgingEvents();
+    for (; next_sample < to; next_sample += interval) {
+        if (busy) {
+            interval_busy += next_sample - cursor;
+        }
+        TelemetrySample sample;
+        sample.time = next_sample;
+        sample.queue_length = length;
+        queue.getEffectivePriorityRange(next_sample, sample.min_priority, sample.max_priority);
+        sample.aging_events = events - last_aging_events;
+        sample.busy_ticks = interval_busy;
+        sample.cpu_busy = busy;
+        push(sample);
+
+        last_aging_events = events;
+        interval_busy = 0;
+        cursor = next_sample;
+    }
+    if (busy) {
+        interval_busy += to - cursor;
+    }
+}
+
+#endif // TELEMETRY_H
@@ -0,0 +1,208 @@
+#ifndef TIMING_WHEEL_H
+#define TIMING_WHEEL_H
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Hierarchical timing wheel: timers keyed by a non-negative integer expiry
+// time, O(1) to schedule and O(1) amortized to expire.
+//
+// Level L has SLOTS slots of SLOTS^L time units each. A timer goes to the
+// highest level at which its expiry differs from the wheel's current time
+// (the slot its expiry falls in there), so it is at most LEVELS - 1 steps
+// from level 0, and LEVELS levels cover every long long time. When time
+// reaches the start of a higher-level slot, its timers cascade down; a
+// level-0 slot holds timers for exactly one time unit. A bitmap per level
+// tracks occupied slots, so advancing far ahead touches only occupied slots,
+// never the empty time in between.
+//
+// Slots are arrays rather than linked lists, so expiring and cascading a
+// slot reads contiguous memory. Expired timers come out of a due list in
+// (expiry, scheduling order), so the order is the same however the wheel
+// was advanced (one unit at a time or in jumps).
+template <typename Payload>
+class TimingWheel {
+public:
+    static constexpr int SLOT_BITS = 6;
+    static constexpr int SLOTS = 1 << SLOT_BITS;                        // Per level
+    static constexpr int LEVELS = (64 + SLOT_BITS - 1) / SLOT_BITS;
+    static constexpr long long NEVER = LLONG_MAX;
+
+private:
+    struct Timer {
+        long long expiry;
+        uint64_t sequence;      // Scheduling order, the tie-break among equal expiries
+        Payload payload;
+    };
+
+    std::vector<Timer> slots[LEVELS][SLOTS];
+    uint64_t occupied[LEVELS];          // Bit per non-empty slot
+    long long now;                      // Everything expiring by now is due
+    uint64_t next_sequence;
+    std::size_t pending;                // Timers still in the wheel
+    std::vector<Timer> cascading;       // Scratch: the slot being emptied
+
+    std::vector<Timer> due;             // Expired, in (expiry, sequence) order
+    std::size_t due_head;
+
+    static int lowestBit(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(word);
+#else
+        int bit = 0;
+        while (!(word & 1)) {
+            word >>= 1;
+            bit++;
+        }
+        return bit;
+#endif
+    }
+
+    static int highestBit(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+        return 63 - __builtin_clzll(word);
+#else
+        int bit = 0;
+        while (word >>= 1) {
+            bit++;
+        }
+        return bit;
+#endif
+    }
+
+    static int slotOf(long long time, int level) {
+        return static_cast<int>((static_cast<uint64_t>(time) >> (level * SLOT_BITS)) & (SLOTS - 1));
+    }
+
+    // First time unit of the level-L slot range containing time
+    static long long levelStart(long long time, int level) {
+        int bits = (level + 1) * SLOT_BITS;
+        return bits >= 63 ? 0 : time >> bits << bits;
+    }
+
+    void link(const Timer& timer) {
+        uint64_t differ = static_cast<uint64_t>(timer.expiry ^ now);
+        int level = differ < SLOTS ? 0 : highestBit(differ) / SLOT_BITS;
+        int slot = slotOf(timer.expiry, level);
+        slots[level][slot].push_back(timer);
+        occupied[level] |= 1ULL << slot;
+    }
+
+    // Earliest time some slot needs handling (its timers expire or
+    // cascade), and at which level; NEVER when the wheel is empty. Timers
+    // on a lower level all lie in the current slot of every level above,
+    // so the lowest occupied level decides.
+    long long nextAttention(int& level) const {
+        for (level = 0; level < LEVELS; level++) {
+            int current = slotOf(now, level);
+            // Level 0 includes the current unit; higher levels only hold
+            // slots after the current one
+            uint64_t ahead = level == 0 ? ~0ULL << current
+                           : current == SLOTS - 1 ? 0 : ~0ULL << (current + 1);
+            uint64_t candidates = occupied[level] & ahead;
+            if (candidates) {
+                long long slot = lowestBit(candidates);
+                return levelStart(now, level) | (slot << (level * SLOT_BITS));
+            }
+        }
+        return NEVER;
+    }
+
+public:
+    TimingWheel() { clear(); }
+
+    // Adds a timer; an expiry already passed is due at the next advance()
+    void schedule(long long expiry, const Payload& payload) {
+        link(Timer{std::max(expiry, now), next_sequence++, payload});
+        pending++;
+    }
+
+    // Moves every timer expiring by time to the due list
+    void advance(long long time) {
+        if (due_head == due.size()) {
+            due.clear();
+            due_head = 0;
+        }
+        std::size_t first = due.size();
+        bool ordered = true;
+        int level;
+        for (long long at = nextAttention(level); at <= time; at = nextAttention(level)) {
+            now = at;
+            int slot = slotOf(at, level);
+            occupied[level] &= ~(1ULL << slot);
+            if (level == 0) {
+                // All expire at `at`; a slot is in scheduling order unless a
+                // cascade appended older timers behind newer ones
+                std::vector<Timer>& expired = slots[0][slot];
+                for (const Timer& timer : expired) {
+                    ordered = ordered && (due.size() == first || due.back().expiry < timer.expiry ||
+                                          due.back().sequence < timer.sequence);
+                    due.push_back(timer);
+                }
+                pending -= expired.size();
+                expired.clear();
+            } else {
+                cascading.swap(slots[level][slot]);
+                for (const Timer& timer : cascading) {
+                    link(timer);
+                }
+                cascading.clear();
+            }
+        }
+        now = std::max(now, time);
+        if (!ordered) {
+            std::sort(due.begin() + first, due.end(), [](const Timer& a, const Timer& b) {
+                return a.expiry != b.expiry ? a.expiry < b.expiry : a.sequence < b.sequence;
+            });
+        }
+    }
+
+    // Due timers, earliest first
+    bool hasDue() const { return due_head < due.size(); }
+    long long dueTime() const { return due[due_head].expiry; }
+    Payload popDue() { return due[due_head++].payload; }
+
+    // Earliest expiry not yet handed out (due or still in the wheel),
+    // NEVER if none. O(1) when a level-0 slot is occupied, otherwise a
+    // scan of the first occupied slot on the lowest occupied level.
+    long long nextExpiry() const {
+        if (hasDue()) {
+            return dueTime();
+        }
+        int level;
+        long long at = nextAttention(level);
+        if (at == NEVER || level == 0) {
+            return at;
+        }
+        long long earliest = NEVER;
+        for (const Timer& timer : slots[level][slotOf(at, level)]) {
+            earliest = std::min(earliest, timer.expiry);
+        }
+        return earliest;
+    }
+
+    // State
+    bool empty() const { return pending == 0 && !hasDue(); }
+    std::size_t size() const { return pending + (due.size() - due_head); }
+    long long getTime() const { return now; }
+
+    // Drops every timer and restarts at time 0
+    void clear() {
+        for (auto& level : slots) {
+            for (auto& slot : level) {
+                slot.clear();
+            }
+        }
+        std::fill(occupied, occupied + LEVELS, 0);
+        now = 0;
+        next_sequence = 0;
+        pending = 0;
+        due.clear();
+        due_head = 0;
+    }
+};
+
+#endif // TIMING_WHEEL_H
@@ -0,0 +1,151 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// One process in a workload trace. io_interval > 0 makes it I/O-bound:
+// it blocks for io_time after every io_interval units of CPU (see Process).
+struct TraceRecord {
+    int id;
+    int priority;
+    long long arrival;
+    int burst;
+    int io_interval = 0;
+    int io_time = 0;
+};
+
+// Anything that yields workload records in arrival order, one at a time
+// (a trace file, a generator). The scheduler pulls from it during a run.
+class WorkloadSource {
+public:
+    virtual ~WorkloadSource() = default;
+    virtual const TraceRecord* peek() = 0;  // nullptr when exhausted
+    virtual void advance() = 0;             // Consume the peeked record
+};
+
+// Streams a record vector owned elsewhere (sorted by arrival). Any number of
+// sources can share one vector read-only.
+class RecordSource : public WorkloadSource {
+private:
+    const std::vector<TraceRecord>& records;
+    size_t position;
+
+public:
+    explicit RecordSource(const std::vector<TraceRecord>& records) : records(records), position(0) {}
+
+    const TraceRecord* peek() override { return position < records.size() ? &records[position] : nullptr; }
+    void advance() override { position++; }
+};
+
+// Trace file formats.
+//  Csv:    one "id,priority,arrival,burst[,io_interval,io_time]" line per
+//          process; blank lines, '#' comments and a header line are skipped.
+//  Binary: 16-byte header ("PQTRACE1" + uint64 record count) followed by
+//          packed 20-byte records: int32 id, int32 priority, int64 arrival,
+//          int32 burst. All fields are little-endian, read and written
+//          byte by byte, so files move between hosts of either byte order.
+//          CPU-bound records only.
+//  Auto:   Binary if the file starts with the magic, otherwise Csv.
+enum class TraceFormat {
+    Auto,
+    Csv,
+    Binary
+};
+
+// Streaming reader for large traces.
+//
+// The file is memory-mapped and consumed front to back in windows: a CSV
+// window is split into newline-aligned chunks parsed in parallel, one per
+// thread. Records are handed out in file order; each window is sorted by
+// arrival, so traces only need to be sorted up to window granularity.
+// Records that arrive earlier than one already handed out are still
+// delivered (and counted by getLateRecords()). Pages behind the read
+// position are released, so memory stays at one window whatever the
+// trace size.
+class TraceReader : public WorkloadSource {
+public:
+    static constexpr size_t DEFAULT_CHUNK_BYTES = 4 << 20;
+    static constexpr size_t BINARY_WINDOW_RECORDS = 1 << 18;
+
+private:
+    // Mapping
+    const char* data;
+    size_t size;
+#ifdef _WIN32
+    void* file_handle;
+    void* mapping_handle;
+#else
+    int fd;
+#endif
+
+    std::string path;
+    TraceFormat format;
+    size_t offset;                  // Next unparsed byte
+    size_t released;                // Bytes already returned to the OS
+    long long lines_before;         // CSV lines before offset (for error messages)
+    int threads;
+    size_t chunk_bytes;
+
+    // Current window
+    std::vector<TraceRecord> window;
+    size_t position;
+
+    long long records_read;
+    long long late_records;
+    long long last_arrival;
+    std::string error;
+
+    bool refill();
+    bool refillCsv();
+    bool refillBinary();
+    void releaseConsumed();
+
+public:
+    // threads = 0 uses one per hardware thread
+    explicit TraceReader(int threads = 0, size_t chunk_bytes = DEFAULT_CHUNK_BYTES);
+    ~TraceReader() override;
+
+    TraceReader(const TraceReader&) = delete;
+    TraceReader& operator=(const TraceReader&) = delete;
+
+    bool open(const std::string& path, TraceFormat format = TraceFormat::Auto);
+    void close();
+
+    // Streaming access, in arrival order within each window
+    const TraceRecord* peek() override;     // nullptr at the end or on error
+    void advance() override;
+    bool next(TraceRecord& record);
+
+    // State
+    bool failed() const { return !error.empty(); }
+    const std::string& getError() const { return error; }
+    long long getRecordsRead() const { return records_read; }
+    long long getLateRecords() const { return late_records; }
+    TraceFormat getFormat() const { return format; }
+};
+
+// Writes the binary format record by record; the count in the header is
+// filled in by close()
+class TraceWriter {
+private:
+    std::FILE* file;
+    uint64_t count;
+
+public:
+    TraceWriter();
+    ~TraceWriter();
+
+    TraceWriter(const TraceWriter&) = delete;
+    TraceWriter& operator=(const TraceWriter&) = delete;
+
+    bool open(const std::string& path);
+    bool write(const TraceRecord& record);     // False for I/O-bound records
+    bool close();
+    uint64_t getCount() const { return count; }
+};
+
+#endif // TRACE_H
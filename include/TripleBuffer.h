@@ -0,0 +1,52 @@
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+#include <atomic>
+#include <cstdint>
+
+// Lock-free single-producer / single-consumer "latest value" buffer.
+//
+// The producer fills writeBuffer() and publish()es it; the consumer calls
+// update() and reads readBuffer(). Three slots rotate through one atomic
+// exchange each, so neither side ever waits for the other. Values the
+// consumer did not get to are overwritten (it always sees the newest), and
+// slots are reused, so values holding vectors or strings stop allocating
+// once warmed up.
+template <typename T>
+class TripleBuffer {
+private:
+    static constexpr uint8_t INDEX = 0x3;
+    static constexpr uint8_t FRESH = 0x4;    // Middle slot not yet read
+
+    T slots[3];
+    uint8_t back;                   // Producer's slot
+    uint8_t front;                  // Consumer's slot
+    std::atomic<uint8_t> middle;    // Handoff slot | FRESH
+
+public:
+    TripleBuffer() : back(0), front(1), middle(2) {}
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // Producer side
+    T& writeBuffer() { return slots[back]; }
+    void publish() {
+        back = middle.exchange(static_cast<uint8_t>(back | FRESH), std::memory_order_acq_rel) & INDEX;
+    }
+
+    // True while the last published value is unread
+    bool fresh() const { return (middle.load(std::memory_order_acquire) & FRESH) != 0; }
+
+    // Consumer side: takes the newest value, false if nothing new
+    bool update() {
+        if (!fresh()) {
+            return false;
+        }
+        front = middle.exchange(front, std::memory_order_acq_rel) & INDEX;
+        return true;
+    }
+    const T& readBuffer() const { return slots[front]; }
+};
+
+#endif // TRIPLE_BUFFER_H
@@ -1,6 +1,7 @@
 #ifndef VISUALIZER_H
 #define VISUALIZER_H
 
+#include "ExecutionLog.h"
 #include "Process.h"
 #include "PriorityQueue.h"
 #include <string>
@@ -8,27 +9,32 @@
 
 class Visualizer {
 public:
-    // Console utilities
+    // Console utilities. Output is buffered ('\n', not std::endl); callers
+    // flush when a frame is complete.
+    static bool enableAnsi();       // ANSI escape sequences work on the console
     static void clearScreen();
     static void printHeader(const std::string& title);
     static void printSeparator(char c = '-', int width = 60);
+    static int terminalWidth();     // Columns of the attached terminal (80 if unknown)
 
     // Process visualization
     static void displayProcess(const Process* process, bool detailed = false);
-    static void displayProcessList(const std::vector<Process*>& processes, const std::string& title);
+    static void displayProcessList(const std::vector<const Process*>& processes, const std::string& title);
 
     // Queue visualization
     static void displayQueue(const PriorityQueue& queue, const std::string& title = "Current Queue");
 
     // Progress indicators
     static void displayProgressBar(int current, int total, int width = 40);
-    static void displayTimeStep(int current_time, const std::string& event = "");
+    static void displayTimeStep(long long current_time, const std::string& event = "");
 
-    // Gantt chart
-    static void displayGanttChart(const std::vector<Process*>& processes);
+    // Gantt chart from an execution log, scaled to fit width columns
+    // (0 = terminal width): one row per process for small runs, otherwise
+    // one row per core
+    static void displayGanttChart(const ExecutionLog& log, int width = 0);
 
     // Execution snapshot
-    static void displayExecutionSnapshot(int current_time,
+    static void displayExecutionSnapshot(long long current_time,
                                         const Process* running_process,
                                         const PriorityQueue& queue,
                                         int completed_count);
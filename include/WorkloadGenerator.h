@@ -0,0 +1,113 @@
+#ifndef WORKLOAD_GENERATOR_H
+#define WORKLOAD_GENERATOR_H
+
+#include "ProcessTable.h"
+#include "Trace.h"
+#include <cstdint>
+#include <vector>
+
+enum class ArrivalPattern {
+    Uniform,    // Spread uniformly over [0, horizon]
+    Poisson,    // Exponential interarrival gaps
+    Bursty      // Two-state Markov-modulated Poisson: quiet and burst phases
+};
+
+enum class BurstDistribution {
+    Uniform,    // min_burst..max_burst
+    Pareto      // Heavy tail from min_burst, capped at max_burst
+};
+
+// Shape of a synthetic workload. Identical specs give identical workloads
+// for any thread count with a given build; across platforms they can differ
+// in the last bit of log1p()/pow(), and so in an occasional record.
+struct WorkloadSpec {
+    static constexpr uint64_t DEFAULT_SEED = 1;
+
+    uint64_t seed = DEFAULT_SEED;
+    long long count = 1000;
+
+    // Arrivals
+    ArrivalPattern arrivals = ArrivalPattern::Poisson;
+    long long horizon = 1000;           // Uniform: last possible arrival time
+    double mean_interarrival = 5.0;     // Poisson, Bursty (quiet phase)
+    double burst_rate = 10.0;           // Bursty: arrival rate multiplier in a burst
+    double burst_share = 0.2;           // Bursty: long-run share of jobs arriving in bursts
+    double burst_length = 50.0;         // Bursty: mean jobs per burst
+
+    // Execution times
+    BurstDistribution bursts = BurstDistribution::Uniform;
+    int min_burst = 1;
+    int max_burst = 10;
+    double pareto_alpha = 1.5;          // Smaller is heavier; mean is finite above 1
+
+    // Priorities 1..max_priority, weighted by Zipf exponent priority_skew on
+    // the distance from the least urgent level: 0 is uniform, > 0 makes
+    // low-urgency work dominate, < 0 makes urgent work dominate
+    int max_priority = 10;
+    double priority_skew = 0.0;
+
+    // I/O: a share io_share of the jobs alternate CPU and I/O bursts, each
+    // blocking after every 1..max_io_interval units of CPU for
+    // 1..max_io_time units (both drawn per job). 0 = all CPU-bound.
+    double io_share = 0.0;
+    int max_io_interval = 4;
+    int max_io_time = 20;
+};
+
+// Deterministic parallel workload generator.
+//
+// Jobs are produced directly in arrival order in fixed blocks of BLOCK_SIZE.
+// Every block draws from its own random substreams derived from the seed and
+// the block number, so blocks are generated on any number of threads and
+// still come out bit-identical for a given build (see WorkloadSpec); block
+// start times are a prefix sum of block durations. Records stream out a
+// window of blocks at a time (the generator is a WorkloadSource), so 10^8
+// jobs need no more memory than 10^3.
+class WorkloadGenerator : public WorkloadSource {
+public:
+    static constexpr long long BLOCK_SIZE = 1 << 16;
+
+private:
+    struct Block {
+        std::vector<TraceRecord> records;
+        std::vector<double> times;      // Arrival times relative to the block start
+        double duration;                // Sum of the block's gaps
+    };
+
+    WorkloadSpec spec;
+    int threads;
+    std::vector<double> priority_cdf;
+    std::vector<double> block_offsets;  // Uniform only: start of every block, precomputed
+    double total_duration;              // Uniform only
+
+    // Stream position
+    long long next_block;
+    double offset;                      // Start time of next_block
+    std::vector<Block> window;
+    size_t window_block;
+    size_t position;
+    long long generated;
+
+    long long blockCount() const;
+    double generateGaps(long long block, std::vector<double>* times) const;
+    void generateBlock(long long block, Block& out) const;
+    bool refill();
+
+public:
+    // threads = 0 uses one per hardware thread
+    explicit WorkloadGenerator(const WorkloadSpec& spec, int threads = 0);
+
+    // Streaming access
+    const TraceRecord* peek() override;
+    void advance() override;
+    bool next(TraceRecord& record);
+    void reset();                       // Start over from the first job
+
+    // Appends the whole workload (in arrival order) to a table
+    void generate(ProcessTable& table);
+
+    long long getGenerated() const { return generated; }
+    const WorkloadSpec& getSpec() const { return spec; }
+};
+
+#endif // WORKLOAD_GENERATOR_H
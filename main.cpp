@@ -1,4 +1,7 @@
 #include "Scheduler.h"
+#include "MultiCoreScheduler.h"
+#include "BatchRunner.h"
+#include "ParameterSweep.h"
 #include "Visualizer.h"
 #include <iostream>
 #include <iomanip>
@@ -13,6 +16,7 @@ void runScenario1() {
     std::cout << "\n";
 
     Scheduler scheduler(0.0, false);
+    scheduler.enableExecutionLog();
 
     scheduler.addProcess(1, 1, 0, 5);
     scheduler.addProcess(2, 8, 1, 3);
@@ -38,6 +42,7 @@ void runScenario2() {
     std::cout << "\n";
 
     Scheduler scheduler(0.1, false);
+    scheduler.enableExecutionLog();
 
     scheduler.addProcess(1, 1, 0, 5);
     scheduler.addProcess(2, 8, 1, 3);
@@ -63,6 +68,7 @@ void runScenario3() {
     std::cout << "\n";
 
     Scheduler scheduler(0.5, false);
+    scheduler.enableExecutionLog();
 
     scheduler.addProcess(1, 1, 0, 5);
     scheduler.addProcess(2, 8, 1, 3);
@@ -89,6 +95,7 @@ void runScenario4() {
     std::cout << "\n";
 
     Scheduler scheduler(0.15, false);
+    scheduler.enableExecutionLog();
     scheduler.generateRandomProcesses(15, 10, 15, 8);
 
     scheduler.displayProcessList();
@@ -107,6 +114,7 @@ void runInteractiveDemo() {
     std::cout << "\n";
 
     Scheduler scheduler(0.2, true);
+    scheduler.enableExecutionLog();
 
     scheduler.addProcess(1, 2, 0, 4);
     scheduler.addProcess(2, 7, 1, 3);
@@ -115,10 +123,16 @@ void runInteractiveDemo() {
     scheduler.addProcess(5, 1, 4, 4);
 
     scheduler.displayProcessList();
-    scheduler.setVisualizationDelay(100);
-    scheduler.run();
+    std::cout << "\nPress Enter to start...";
+    std::cin.get();
+
+    // Live view drawn by a render thread, paced at 100 ms per time unit
+    scheduler.runWithVisualization(100);
     scheduler.displayGanttChart();
     scheduler.displayStatistics();
+
+    std::cout << "\nPress Enter to continue...";
+    std::cin.get();
 }
 
 void compareAgingFactors() {
@@ -127,6 +141,17 @@ void compareAgingFactors() {
     double factors[] = {0.0, 0.05, 0.1, 0.2, 0.5};
     const char* labels[] = {"No Aging", "Conservative", "Moderate", "Aggressive", "Very Aggressive"};
 
+    // One shared workload, one grid point per factor, run in parallel
+    ParameterSweep sweep;
+    sweep.addWorkload("demo", {{1, 1, 0, 5}, {2, 8, 1, 3}, {3, 1, 2, 4}, {4, 9, 3, 2}, {5, 1, 4, 3}});
+    SweepPolicy policy;
+    SweepPolicy::parse("nonpreemptive", policy);
+    sweep.addPolicy(policy);
+    for (double factor : factors) {
+        sweep.addAgingFactor(factor);
+    }
+    std::vector<SweepResult> results = sweep.run();
+
     std::cout << std::left << std::setw(20) << "Aging Factor"
               << std::setw(15) << "Avg Wait"
               << std::setw(15) << "Avg Turnaround"
@@ -134,18 +159,8 @@ void compareAgingFactors() {
               << "Aging Events" << std::endl;
     Visualizer::printSeparator('=', 80);
 
-    for (int i = 0; i < 5; i++) {
-        Scheduler scheduler(factors[i], false);
-
-        scheduler.addProcess(1, 1, 0, 5);
-        scheduler.addProcess(2, 8, 1, 3);
-        scheduler.addProcess(3, 1, 2, 4);
-        scheduler.addProcess(4, 9, 3, 2);
-        scheduler.addProcess(5, 1, 4, 3);
-
-        scheduler.run();
-        Statistics stats = scheduler.getStatistics();
-
+    for (size_t i = 0; i < results.size(); i++) {
+        const Statistics& stats = results[i].stats;
         std::cout << std::left << std::setw(20) << labels[i]
                   << std::setw(15) << std::fixed << std::setprecision(2) << stats.getAverageWaitingTime()
                   << std::setw(15) << stats.getAverageTurnaroundTime()
@@ -158,6 +173,29 @@ void compareAgingFactors() {
     std::cin.get();
 }
 
+void runMultiCoreScenario() {
+    Visualizer::printHeader("MULTI-CORE SCHEDULING (Work Stealing)");
+    std::cout << "\nThis scenario schedules 40 random processes on 4 cores:" << std::endl;
+    std::cout << "- One aging queue per core, arrivals placed round-robin" << std::endl;
+    std::cout << "- Idle cores steal from the busiest core every 10 time units" << std::endl;
+    std::cout << "- Migration Cost: 2 time units" << std::endl;
+    std::cout << "- Aging Factor: 0.1" << std::endl;
+    std::cout << "\n";
+
+    MultiCoreScheduler scheduler(4, 0.1, true);
+    scheduler.setSyncInterval(10);
+    scheduler.setMigrationCost(2);
+    scheduler.generateRandomProcesses(40, 10, 30, 12);
+    scheduler.enableExecutionLog();
+
+    scheduler.run();
+    scheduler.displayGanttChart();
+    scheduler.displayStatistics();
+
+    std::cout << "\nPress Enter to continue...";
+    std::cin.get();
+}
+
 void displayMenu() {
     Visualizer::clearScreen();
     Visualizer::printHeader("Priority Queue with Aging - Demo Program");
@@ -169,13 +207,19 @@ void displayMenu() {
     std::cout << "  5. Interactive Demo (Real-time Visualization)" << std::endl;
     std::cout << "  6. Compare Different Aging Factors" << std::endl;
     std::cout << "  7. Run All Scenarios" << std::endl;
+    std::cout << "  8. Multi-Core Scheduling (Work Stealing)" << std::endl;
     std::cout << "  0. Exit" << std::endl;
     std::cout << "\n";
     Visualizer::printSeparator('-', 60);
     std::cout << "Select option: ";
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+    // Any option selects the headless batch mode
+    if (argc > 1) {
+        return BatchRunner::main(argc, argv);
+    }
+
     int choice;
 
     while (true) {
@@ -213,8 +257,13 @@ int main() {
                 Visualizer::clearScreen();
                 runScenario4();
                 Visualizer::clearScreen();
+                runMultiCoreScenario();
+                Visualizer::clearScreen();
                 compareAgingFactors();
                 break;
+            case 8:
+                runMultiCoreScenario();
+                break;
             case 0:
                 std::cout << "\nExiting... Thank you!" << std::endl;
                 return 0;
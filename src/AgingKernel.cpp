@@ -0,0 +1,168 @@
+#include "AgingKernel.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define AGING_KERNEL_X86 1
+#include <immintrin.h>
+#else
+#define AGING_KERNEL_X86 0
+#endif
+
+namespace {
+
+// Every version evaluates the same operations in the same order, so they
+// agree bit for bit (no FMA: -std=c++17 turns contraction off)
+template <bool Stepped>
+size_t recomputeScalar(const double* origin, const double* base, double* effective,
+                       size_t count, double now, double factor, AgingShape shape) {
+    size_t changed = 0;
+    for (size_t i = 0; i < count; i++) {
+        double waited = std::max(0.0, now - origin[i]);
+        if (Stepped) {
+            waited = std::floor(waited / shape.step) * shape.step;
+        }
+        double value = std::max(0.0, base[i] - std::min(waited * factor, shape.cap));
+        changed += value != effective[i];
+        effective[i] = value;
+    }
+    return changed;
+}
+
+#if AGING_KERNEL_X86
+
+template <bool Stepped>
+__attribute__((target("avx2")))
+size_t recomputeAvx2(const double* origin, const double* base, double* effective,
+                     size_t count, double now, double factor, AgingShape shape) {
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d time = _mm256_set1_pd(now);
+    const __m256d rate = _mm256_set1_pd(factor);
+    const __m256d step = _mm256_set1_pd(shape.step);
+    const __m256d cap = _mm256_set1_pd(shape.cap);
+
+    size_t changed = 0;
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256d waited = _mm256_max_pd(_mm256_sub_pd(time, _mm256_loadu_pd(origin + i)), zero);
+        if (Stepped) {
+            waited = _mm256_mul_pd(_mm256_floor_pd(_mm256_div_pd(waited, step)), step);
+        }
+        __m256d boost = _mm256_min_pd(_mm256_mul_pd(waited, rate), cap);
+        __m256d value = _mm256_max_pd(_mm256_sub_pd(_mm256_loadu_pd(base + i), boost), zero);
+        __m256d moved = _mm256_cmp_pd(value, _mm256_loadu_pd(effective + i), _CMP_NEQ_UQ);
+        changed += __builtin_popcount(_mm256_movemask_pd(moved));
+        _mm256_storeu_pd(effective + i, value);
+    }
+    return changed + recomputeScalar<Stepped>(origin + i, base + i, effective + i,
+                                              count - i, now, factor, shape);
+}
+
+// GCC 12's AVX-512 headers trip -Wmaybe-uninitialized at -O3 (their
+// _mm512_undefined_pd() pass-through operands)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+template <bool Stepped>
+__attribute__((target("avx512f")))
+size_t recomputeAvx512(const double* origin, const double* base, double* effective,
+                       size_t count, double now, double factor, AgingShape shape) {
+    const __m512d zero = _mm512_setzero_pd();
+    const __m512d time = _mm512_set1_pd(now);
+    const __m512d rate = _mm512_set1_pd(factor);
+    const __m512d step = _mm512_set1_pd(shape.step);
+    const __m512d cap = _mm512_set1_pd(shape.cap);
+
+    size_t changed = 0;
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m512d waited = _mm512_max_pd(_mm512_sub_pd(time, _mm512_loadu_pd(origin + i)), zero);
+        if (Stepped) {
+            waited = _mm512_mul_pd(_mm512_roundscale_pd(_mm512_div_pd(waited, step),
+                                                        _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC),
+                                   step);
+        }
+        __m512d boost = _mm512_min_pd(_mm512_mul_pd(waited, rate), cap);
+        __m512d value = _mm512_max_pd(_mm512_sub_pd(_mm512_loadu_pd(base + i), boost), zero);
+        __mmask8 moved = _mm512_cmp_pd_mask(value, _mm512_loadu_pd(effective + i), _CMP_NEQ_UQ);
+        changed += __builtin_popcount(moved);
+        _mm512_storeu_pd(effective + i, value);
+    }
+    return changed + recomputeScalar<Stepped>(origin + i, base + i, effective + i,
+                                              count - i, now, factor, shape);
+}
+
+#pragma GCC diagnostic pop
+
+#endif
+
+bool supported(AgingKernel kernel) {
+#if AGING_KERNEL_X86
+    __builtin_cpu_init();
+    switch (kernel) {
+        case AgingKernel::Avx512: return __builtin_cpu_supports("avx512f");
+        case AgingKernel::Avx2:   return __builtin_cpu_supports("avx2");
+        default:                  return true;
+    }
+#else
+    return kernel == AgingKernel::Scalar || kernel == AgingKernel::Auto;
+#endif
+}
+
+AgingKernel widest() {
+    if (supported(AgingKernel::Avx512)) {
+        return AgingKernel::Avx512;
+    }
+    return supported(AgingKernel::Avx2) ? AgingKernel::Avx2 : AgingKernel::Scalar;
+}
+
+std::atomic<AgingKernel>& selected() {
+    static std::atomic<AgingKernel> kernel(widest());
+    return kernel;
+}
+
+template <bool Stepped>
+size_t dispatch(const double* origin, const double* base, double* effective,
+                size_t count, double now, double factor, AgingShape shape) {
+    switch (selected().load(std::memory_order_relaxed)) {
+#if AGING_KERNEL_X86
+        case AgingKernel::Avx512:
+            return recomputeAvx512<Stepped>(origin, base, effective, count, now, factor, shape);
+        case AgingKernel::Avx2:
+            return recomputeAvx2<Stepped>(origin, base, effective, count, now, factor, shape);
+#endif
+        default:
+            return recomputeScalar<Stepped>(origin, base, effective, count, now, factor, shape);
+    }
+}
+
+}
+
+size_t recomputeEffective(const double* origin, const double* base, double* effective,
+                          size_t count, long long time, double factor, AgingShape shape) {
+    double now = static_cast<double>(time);
+    if (shape.step == 1.0) {
+        // Waiting times are whole time units already
+        return dispatch<false>(origin, base, effective, count, now, factor, shape);
+    }
+    return dispatch<true>(origin, base, effective, count, now, factor, shape);
+}
+
+void setAgingKernel(AgingKernel kernel) {
+    selected().store(kernel == AgingKernel::Auto || !supported(kernel) ? widest() : kernel,
+                     std::memory_order_relaxed);
+}
+
+AgingKernel activeAgingKernel() {
+    return selected().load(std::memory_order_relaxed);
+}
+
+const char* agingKernelName(AgingKernel kernel) {
+    switch (kernel) {
+        case AgingKernel::Avx512: return "avx512";
+        case AgingKernel::Avx2:   return "avx2";
+        case AgingKernel::Scalar: return "scalar";
+        default:                  return "auto";
+    }
+}
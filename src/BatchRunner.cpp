@@ -0,0 +1,858 @@
+#include "BatchRunner.h"
+#include "MultiCoreScheduler.h"
+#include "Scheduler.h"
+#include "Visualizer.h"
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+bool parseLong(const std::string& text, long long min_value, long long& value) {
+    if (text.empty()) return false;
+    char* end = nullptr;
+    errno = 0;
+    long long parsed = std::strtoll(text.c_str(), &end, 10);
+    if (errno != 0 || *end != '\0' || parsed < min_value) return false;
+    value = parsed;
+    return true;
+}
+
+bool parseInt(const std::string& text, int min_value, int& value) {
+    long long parsed;
+    if (!parseLong(text, min_value, parsed) || parsed > 2147483647LL) return false;
+    value = static_cast<int>(parsed);
+    return true;
+}
+
+bool parseDouble(const std::string& text, double& value) {
+    if (text.empty()) return false;
+    char* end = nullptr;
+    errno = 0;
+    double parsed = std::strtod(text.c_str(), &end);
+    if (errno != 0 || *end != '\0' || !std::isfinite(parsed) || parsed < 0.0) return false;
+    value = parsed;
+    return true;
+}
+
+bool parseBool(const std::string& text, bool& value) {
+    if (text == "true" || text == "1" || text == "yes" || text == "on") {
+        value = true;
+    } else if (text == "false" || text == "0" || text == "no" || text == "off") {
+        value = false;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+std::string trim(const std::string& text) {
+    size_t begin = text.find_first_not_of(" \t\r");
+    if (begin == std::string::npos) return "";
+    size_t end = text.find_last_not_of(" \t\r");
+    return text.substr(begin, end - begin + 1);
+}
+
+std::vector<std::string> splitList(const std::string& text) {
+    std::vector<std::string> items;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        item = trim(item);
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+// Reads the whole trace through the streaming reader (for the multi-core
+// scheduler and per-process output, which keep every record)
+template <typename Add>
+bool loadTrace(const BatchConfig& config, Add add, std::string& error) {
+    TraceReader reader(config.load_threads);
+    if (!reader.open(config.trace_path, config.trace_format)) {
+        error = reader.getError();
+        return false;
+    }
+    TraceRecord record;
+    while (reader.next(record)) {
+        add(record);
+    }
+    error = reader.getError();
+    return !reader.failed();
+}
+
+const char* ruleName(AgingRule rule) {
+    switch (rule) {
+        case AgingRule::Exponential: return ExponentialAging::NAME;
+        case AgingRule::Step:        return StepAging<>::NAME;
+        case AgingRule::Capped:      return CappedAging<>::NAME;
+        case AgingRule::FixedPoint:  return FixedPointAging::NAME;
+        default:                     return LinearAging::NAME;
+    }
+}
+
+const char* modeName(AgingMode mode) {
+    return mode == AgingMode::Lazy ? "lazy" : "eager";
+}
+
+const char* overflowName(OverflowPolicy policy) {
+    switch (policy) {
+        case OverflowPolicy::EvictLowest:  return "evict";
+        case OverflowPolicy::Backpressure: return "backpressure";
+        default:                           return "reject";
+    }
+}
+
+const char* backendName(QueueBackend backend) {
+    return backend == QueueBackend::Heap ? "heap" : "bucket";
+}
+
+void printResults(const BatchConfig& config, const Statistics& stats,
+                  const std::vector<const Process*>& completed) {
+    switch (config.format) {
+        case OutputFormat::Text:
+            stats.display();
+            if (config.per_process) {
+                std::cout << std::left << std::setw(8) << "ID" << std::setw(10) << "Priority"
+                          << std::setw(10) << "Arrival" << std::setw(8) << "Burst"
+                          << std::setw(10) << "Start" << std::setw(12) << "Completion"
+                          << std::setw(10) << "Waiting" << "Turnaround" << std::endl;
+                for (const Process* p : completed) {
+                    std::cout << std::left << std::setw(8) << p->getId()
+                              << std::setw(10) << p->getBasePriority()
+                              << std::setw(10) << p->getArrivalTime()
+                              << std::setw(8) << p->getBurstTime()
+                              << std::setw(10) << p->getStartTime()
+                              << std::setw(12) << p->getCompletionTime()
+                              << std::setw(10) << p->getWaitingTime()
+                              << p->getTurnaroundTime() << std::endl;
+                }
+            }
+            break;
+
+        case OutputFormat::Json:
+            std::cout << "{\"config\": {\"aging_factor\": " << config.aging_factor
+                      << ", \"aging_policy\": \"" << ruleName(config.aging_rule) << "\""
+                      << ", \"aging_mode\": \"" << modeName(config.aging_mode) << "\""
+                      << ", \"backend\": \"" << backendName(config.backend) << "\""
+                      << ", \"preemptive\": " << (config.preemptive ? "true" : "false")
+                      << ", \"time_quantum\": " << config.time_quantum
+                      << ", \"queue_capacity\": " << config.queue_capacity
+                      << ", \"overflow\": \"" << overflowName(config.overflow) << "\""
+                      << ", \"cores\": " << config.cores << "}";
+            std::cout << ", \"statistics\": " << stats.toJson();
+            if (config.per_process) {
+                std::cout << ", \"processes\": [";
+                for (size_t i = 0; i < completed.size(); i++) {
+                    const Process* p = completed[i];
+                    std::cout << (i > 0 ? ", " : "")
+                              << "{\"id\": " << p->getId()
+                              << ", \"priority\": " << p->getBasePriority()
+                              << ", \"arrival\": " << p->getArrivalTime()
+                              << ", \"burst\": " << p->getBurstTime()
+                              << ", \"start\": " << p->getStartTime()
+                              << ", \"completion\": " << p->getCompletionTime()
+                              << ", \"waiting\": " << p->getWaitingTime()
+                              << ", \"turnaround\": " << p->getTurnaroundTime() << "}";
+                }
+                std::cout << "]";
+            }
+            std::cout << "}" << std::endl;
+            break;
+
+        case OutputFormat::Csv:
+            // Summary row first; per-process rows follow as a second
+            // section after a blank line
+            std::cout << Statistics::csvHeader() << std::endl;
+            std::cout << stats.toCsvRow() << std::endl;
+            if (config.per_process) {
+                std::cout << std::endl;
+                std::cout << "id,priority,arrival,burst,start,completion,waiting,turnaround" << std::endl;
+                for (const Process* p : completed) {
+                    std::cout << p->getId() << ',' << p->getBasePriority() << ','
+                              << p->getArrivalTime() << ',' << p->getBurstTime() << ','
+                              << p->getStartTime() << ',' << p->getCompletionTime() << ','
+                              << p->getWaitingTime() << ',' << p->getTurnaroundTime() << std::endl;
+                }
+            }
+            break;
+    }
+}
+
+void printQueueOps(const QueueOpStats& ops) {
+    auto row = [](const char* name, const QueueOpStats::Op& op) {
+        double calls = op.calls ? static_cast<double>(op.calls) : 1.0;
+        std::cout << std::left << std::setw(14) << name << std::right
+                  << std::setw(14) << op.calls
+                  << std::setw(14) << op.comparisons / calls
+                  << std::setw(12) << op.swaps / calls
+                  << std::setw(12) << op.levels / calls << std::endl;
+    };
+    std::cout << std::endl << "Queue operations (per call):" << std::endl;
+    std::cout << std::left << std::setw(14) << "Operation" << std::right
+              << std::setw(14) << "Calls" << std::setw(14) << "Comparisons"
+              << std::setw(12) << "Swaps" << std::setw(12) << "Levels" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    row("insert", ops.insert);
+    row("extractMin", ops.extract_min);
+    row("insertBatch", ops.insert_batch);
+    row("extractTopK", ops.extract_top_k);
+    row("rebuildHeap", ops.rebuild);
+    std::cout << "applyAging: " << ops.aging_calls << " calls, "
+              << ops.aging_ns / 1e6 << " ms" << std::endl;
+    std::cout << std::defaultfloat << std::setprecision(6);
+}
+
+// Gantt chart (text output) and Chrome trace from the execution slices
+int finishExecutionLog(const BatchConfig& config, const ExecutionLog& log) {
+    if (config.gantt && config.format == OutputFormat::Text) {
+        Visualizer::displayGanttChart(log);
+    }
+    if (config.chrome_trace_path.empty()) {
+        return BatchRunner::EXIT_OK;
+    }
+    std::ofstream out(config.chrome_trace_path);
+    log.writeChromeTrace(out);
+    if (!out) {
+        std::cerr << "Error: cannot write " << config.chrome_trace_path << std::endl;
+        return BatchRunner::EXIT_INPUT;
+    }
+    return BatchRunner::EXIT_OK;
+}
+
+// Single-core extras after the results: queue operation counts (text output
+// of instrumented builds), execution log outputs and the telemetry file
+template <typename SchedulerType>
+int finishSingleCore(const BatchConfig& config, const SchedulerType& scheduler) {
+    if (QUEUE_INSTRUMENTED && config.format == OutputFormat::Text) {
+        printQueueOps(scheduler.getQueueOpStats());
+    }
+    int status = finishExecutionLog(config, scheduler.getExecutionLog());
+    if (status != BatchRunner::EXIT_OK || config.telemetry_path.empty()) {
+        return status;
+    }
+    std::ofstream out(config.telemetry_path);
+    scheduler.getTelemetry().writeCsv(out);
+    if (!out) {
+        std::cerr << "Error: cannot write " << config.telemetry_path << std::endl;
+        return BatchRunner::EXIT_INPUT;
+    }
+    return BatchRunner::EXIT_OK;
+}
+
+// Loads the workload, runs and prints; works with either scheduler
+template <typename SchedulerType>
+int simulate(SchedulerType& scheduler, const BatchConfig& config) {
+    if (!config.trace_path.empty()) {
+        std::string error;
+        bool io = false;
+        auto add = [&scheduler, &io](const TraceRecord& record) {
+            io = io || record.io_interval > 0;
+            scheduler.addProcess(Process(record.id, record.priority, record.arrival, record.burst,
+                                         record.io_interval, record.io_time));
+        };
+        if (!loadTrace(config, add, error)) {
+            std::cerr << "Error: " << error << std::endl;
+            return BatchRunner::EXIT_INPUT;
+        }
+        // Several cores run each process as one CPU burst; refuse rather
+        // than drop the I/O columns
+        if (std::is_same<SchedulerType, MultiCoreScheduler>::value && io) {
+            std::cerr << "Error: I/O columns (io_interval, io_time) are simulated on a single core"
+                      << std::endl;
+            return BatchRunner::EXIT_INPUT;
+        }
+    } else {
+        scheduler.generateWorkload(config.workload);
+    }
+
+    scheduler.run();
+
+    std::vector<const Process*> completed;
+    if (config.per_process) {
+        completed = scheduler.getCompletedProcesses();
+    }
+    printResults(config, scheduler.getStatistics(), completed);
+    return BatchRunner::EXIT_OK;
+}
+
+// Single core without per-process output: the workload is streamed, so
+// memory follows the number of processes in flight, not the workload size
+template <typename SchedulerType>
+int simulateStreaming(SchedulerType& scheduler, const BatchConfig& config) {
+    if (config.trace_path.empty()) {
+        WorkloadGenerator generator(config.workload, config.load_threads);
+        scheduler.setWorkloadSource(&generator);
+        scheduler.run();
+        scheduler.setWorkloadSource(nullptr);
+        printResults(config, scheduler.getStatistics(), {});
+        return finishSingleCore(config, scheduler);
+    }
+
+    TraceReader reader(config.load_threads);
+    // Peeking parses the first window, so early format errors are reported
+    // before the run starts
+    if (!reader.open(config.trace_path, config.trace_format) || (!reader.peek() && reader.failed())) {
+        std::cerr << "Error: " << reader.getError() << std::endl;
+        return BatchRunner::EXIT_INPUT;
+    }
+
+    scheduler.setWorkloadSource(&reader);
+    scheduler.run();
+    scheduler.setWorkloadSource(nullptr);
+    if (reader.failed()) {
+        std::cerr << "Error: " << reader.getError() << std::endl;
+        return BatchRunner::EXIT_INPUT;
+    }
+
+    printResults(config, scheduler.getStatistics(), {});
+    return finishSingleCore(config, scheduler);
+}
+
+// One single-core run with the scheduler specialized on Policy
+template <typename Policy>
+int runSingleCore(const BatchConfig& config) {
+    BasicScheduler<Policy> scheduler(config.aging_factor, false);
+    scheduler.setAgingMode(config.aging_mode);
+    scheduler.setQueueBackend(config.backend);
+    scheduler.setPreemptive(config.preemptive, config.time_quantum);
+    scheduler.setQueueCapacity(static_cast<size_t>(config.queue_capacity), config.overflow);
+    scheduler.enableExecutionLog(config.gantt || !config.chrome_trace_path.empty());
+    if (!config.telemetry_path.empty()) {
+        scheduler.enableTelemetry(config.telemetry_interval,
+                                  static_cast<size_t>(config.telemetry_capacity));
+    }
+    if (!config.per_process) {
+        return simulateStreaming(scheduler, config);
+    }
+    int status = simulate(scheduler, config);
+    return status == BatchRunner::EXIT_OK ? finishSingleCore(config, scheduler) : status;
+}
+
+}
+
+bool BatchRunner::applyOption(const std::string& key, const std::string& value,
+                              BatchConfig& config, std::string& error) {
+    bool ok = true;
+    if (key == "trace") {
+        config.trace_path = value;
+        ok = !value.empty();
+    } else if (key == "trace-format") {
+        ok = value == "auto" || value == "csv" || value == "binary";
+        config.trace_format = value == "csv"    ? TraceFormat::Csv
+                            : value == "binary" ? TraceFormat::Binary
+                                                : TraceFormat::Auto;
+    } else if (key == "load-threads") {
+        ok = parseInt(value, 0, config.load_threads);
+    } else if (key == "convert") {
+        config.convert_path = value;
+        ok = !value.empty();
+    } else if (key == "random") {
+        ok = parseLong(value, 1, config.workload.count) && config.workload.count <= 2147483647LL;
+    } else if (key == "seed") {
+        long long seed = 0;
+        ok = parseLong(value, 0, seed);
+        config.workload.seed = static_cast<uint64_t>(seed);
+    } else if (key == "arrivals") {
+        ok = value == "uniform" || value == "poisson" || value == "bursty";
+        config.workload.arrivals = value == "poisson" ? ArrivalPattern::Poisson
+                                 : value == "bursty"  ? ArrivalPattern::Bursty
+                                                      : ArrivalPattern::Uniform;
+    } else if (key == "max-arrival") {
+        ok = parseLong(value, 0, config.workload.horizon);
+    } else if (key == "mean-interarrival") {
+        ok = parseDouble(value, config.workload.mean_interarrival);
+    } else if (key == "burst-rate") {
+        ok = parseDouble(value, config.workload.burst_rate) && config.workload.burst_rate > 0.0;
+    } else if (key == "burst-share") {
+        ok = parseDouble(value, config.workload.burst_share) && config.workload.burst_share < 1.0;
+    } else if (key == "burst-length") {
+        ok = parseDouble(value, config.workload.burst_length);
+    } else if (key == "burst-dist") {
+        ok = value == "uniform" || value == "pareto";
+        config.workload.bursts = value == "pareto" ? BurstDistribution::Pareto
+                                                   : BurstDistribution::Uniform;
+    } else if (key == "min-burst") {
+        ok = parseInt(value, 1, config.workload.min_burst);
+    } else if (key == "max-burst") {
+        ok = parseInt(value, 1, config.workload.max_burst);
+    } else if (key == "pareto-alpha") {
+        ok = parseDouble(value, config.workload.pareto_alpha) && config.workload.pareto_alpha > 0.0;
+    } else if (key == "io-share") {
+        ok = parseDouble(value, config.workload.io_share) && config.workload.io_share <= 1.0;
+    } else if (key == "io-interval") {
+        ok = parseInt(value, 1, config.workload.max_io_interval);
+    } else if (key == "io-time") {
+        ok = parseInt(value, 1, config.workload.max_io_time);
+    } else if (key == "max-priority") {
+        ok = parseInt(value, 1, config.workload.max_priority);
+    } else if (key == "priority-skew") {
+        char* end = nullptr;
+        config.workload.priority_skew = std::strtod(value.c_str(), &end);
+        ok = !value.empty() && *end == '\0' && std::isfinite(config.workload.priority_skew);
+    } else if (key == "aging") {
+        ok = parseDouble(value, config.aging_factor);
+    } else if (key == "aging-policy") {
+        ok = value == "linear" || value == "exponential" || value == "step" || value == "capped" ||
+             value == "fixed";
+        config.aging_rule = value == "exponential" ? AgingRule::Exponential
+                          : value == "step"        ? AgingRule::Step
+                          : value == "capped"      ? AgingRule::Capped
+                          : value == "fixed"       ? AgingRule::FixedPoint
+                                                   : AgingRule::Linear;
+    } else if (key == "aging-mode") {
+        ok = value == "lazy" || value == "eager";
+        config.aging_mode = value == "eager" ? AgingMode::Eager : AgingMode::Lazy;
+    } else if (key == "backend") {
+        ok = value == "heap" || value == "bucket";
+        config.backend = value == "bucket" ? QueueBackend::Bucket : QueueBackend::Heap;
+    } else if (key == "preemptive") {
+        ok = parseBool(value, config.preemptive);
+    } else if (key == "quantum") {
+        ok = parseInt(value, 0, config.time_quantum);
+    } else if (key == "capacity") {
+        ok = parseLong(value, 0, config.queue_capacity);
+    } else if (key == "overflow") {
+        ok = value == "reject" || value == "evict" || value == "backpressure";
+        config.overflow = value == "evict"        ? OverflowPolicy::EvictLowest
+                        : value == "backpressure" ? OverflowPolicy::Backpressure
+                                                  : OverflowPolicy::Reject;
+    } else if (key == "cores") {
+        ok = parseInt(value, 1, config.cores);
+    } else if (key == "sync-interval") {
+        ok = parseLong(value, 1, config.sync_interval);
+    } else if (key == "migration-cost") {
+        ok = parseLong(value, 0, config.migration_cost);
+    } else if (key == "host-threads") {
+        ok = parseInt(value, 0, config.host_threads);
+    } else if (key == "sweep") {
+        ok = ParameterSweep::parseFactors(value, config.sweep_factors);
+    } else if (key == "sweep-policies") {
+        config.sweep_policies.clear();
+        for (const auto& name : splitList(value)) {
+            SweepPolicy policy;
+            ok = ok && SweepPolicy::parse(name, policy);
+            config.sweep_policies.push_back(policy);
+        }
+        ok = ok && !config.sweep_policies.empty();
+    } else if (key == "sweep-traces") {
+        config.sweep_traces = splitList(value);
+        ok = !config.sweep_traces.empty();
+    } else if (key == "sweep-seeds") {
+        config.sweep_seeds.clear();
+        for (const auto& item : splitList(value)) {
+            long long seed = 0;
+            ok = ok && parseLong(item, 0, seed);
+            config.sweep_seeds.push_back(static_cast<uint64_t>(seed));
+        }
+        ok = ok && !config.sweep_seeds.empty();
+    } else if (key == "sweep-threads") {
+        ok = parseInt(value, 0, config.sweep_threads);
+    } else if (key == "chrome-trace") {
+        config.chrome_trace_path = value;
+        ok = !value.empty();
+    } else if (key == "gantt") {
+        ok = parseBool(value, config.gantt);
+    } else if (key == "telemetry") {
+        config.telemetry_path = value;
+        ok = !value.empty();
+    } else if (key == "telemetry-interval") {
+        ok = parseLong(value, 1, config.telemetry_interval);
+    } else if (key == "telemetry-capacity") {
+        ok = parseLong(value, 1, config.telemetry_capacity);
+    } else if (key == "format") {
+        ok = value == "text" || value == "json" || value == "csv";
+        config.format = value == "json" ? OutputFormat::Json
+                      : value == "csv"  ? OutputFormat::Csv
+                                        : OutputFormat::Text;
+    } else if (key == "per-process") {
+        ok = parseBool(value, config.per_process);
+    } else {
+        error = "unknown option '" + key + "'";
+        return false;
+    }
+
+    if (!ok) {
+        error = "invalid value '" + value + "' for " + key;
+    }
+    return ok;
+}
+
+bool BatchRunner::loadConfigFile(const std::string& path, BatchConfig& config, std::string& error) {
+    std::ifstream in(path);
+    if (!in) {
+        error = "cannot open config file '" + path + "'";
+        return false;
+    }
+
+    std::string line;
+    int line_number = 0;
+    while (std::getline(in, line)) {
+        line_number++;
+        line = trim(line);
+        if (line.empty() || line[0] == '#') continue;
+
+        size_t equals = line.find('=');
+        if (equals == std::string::npos) {
+            error = path + ":" + std::to_string(line_number) + ": expected key=value";
+            return false;
+        }
+        if (!applyOption(trim(line.substr(0, equals)), trim(line.substr(equals + 1)), config, error)) {
+            error = path + ":" + std::to_string(line_number) + ": " + error;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool BatchRunner::parseArguments(int argc, char* argv[], BatchConfig& config, std::string& error,
+                                 bool& show_help) {
+    show_help = false;
+
+    // The config file is applied first so flags can override it
+    for (int i = 1; i < argc; i++) {
+        if (std::string(argv[i]) == "--config") {
+            if (i + 1 >= argc) {
+                error = "--config needs a file";
+                return false;
+            }
+            if (!loadConfigFile(argv[i + 1], config, error)) {
+                return false;
+            }
+        }
+    }
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            show_help = true;
+            return true;
+        }
+        if (arg.compare(0, 2, "--") != 0) {
+            error = "unexpected argument '" + arg + "'";
+            return false;
+        }
+
+        std::string key = arg.substr(2);
+        if (key == "config") {
+            i++;
+            continue;
+        }
+        // Switches take no value
+        if (key == "preemptive" || key == "per-process" || key == "gantt") {
+            applyOption(key, "true", config, error);
+            continue;
+        }
+        if (i + 1 >= argc) {
+            error = arg + " needs a value";
+            return false;
+        }
+        if (!applyOption(key, argv[++i], config, error)) {
+            return false;
+        }
+    }
+
+    if (config.trace_path.empty() && config.workload.count == 0 && config.sweep_traces.empty()) {
+        error = "no workload: use --trace FILE or --random COUNT";
+        return false;
+    }
+    return true;
+}
+
+int BatchRunner::run(const BatchConfig& config) {
+    if (!config.convert_path.empty()) {
+        return convert(config);
+    }
+    if (!config.sweep_factors.empty()) {
+        return sweep(config);
+    }
+
+    if (config.cores > 1) {
+        if (config.aging_rule != AgingRule::Linear) {
+            std::cerr << "Error: --aging-policy other than linear runs a single core" << std::endl;
+            return EXIT_USAGE;
+        }
+        if (!config.telemetry_path.empty()) {
+            std::cerr << "Error: --telemetry samples a single-core schedule" << std::endl;
+            return EXIT_USAGE;
+        }
+        if (config.queue_capacity > 0) {
+            std::cerr << "Error: --capacity bounds a single-core queue" << std::endl;
+            return EXIT_USAGE;
+        }
+        if (config.preemptive || config.time_quantum != 0) {
+            std::cerr << "Error: --preemptive and --quantum run a single core" << std::endl;
+            return EXIT_USAGE;
+        }
+        if (config.aging_mode != AgingMode::Lazy || config.backend != QueueBackend::Heap) {
+            std::cerr << "Error: --aging-mode and --backend configure a single-core queue" << std::endl;
+            return EXIT_USAGE;
+        }
+        if (config.workload.io_share > 0.0) {
+            std::cerr << "Error: --io-share simulates I/O on a single core" << std::endl;
+            return EXIT_USAGE;
+        }
+        MultiCoreScheduler scheduler(config.cores, config.aging_factor, false);
+        scheduler.setSyncInterval(config.sync_interval);
+        scheduler.setMigrationCost(config.migration_cost);
+        scheduler.setHostThreads(config.host_threads);
+        scheduler.enableExecutionLog(config.gantt || !config.chrome_trace_path.empty());
+        int status = simulate(scheduler, config);
+        return status == EXIT_OK ? finishExecutionLog(config, scheduler.getExecutionLog()) : status;
+    }
+
+    switch (config.aging_rule) {
+        case AgingRule::Exponential: return runSingleCore<ExponentialAging>(config);
+        case AgingRule::Step:        return runSingleCore<StepAging<>>(config);
+        case AgingRule::Capped:      return runSingleCore<CappedAging<>>(config);
+        case AgingRule::FixedPoint:
+            // The queue refuses keys wider than the packed layout; the
+            // workload (arrivals, priorities) or the factor is too large
+            try {
+                return runSingleCore<FixedPointAging>(config);
+            } catch (const std::overflow_error& e) {
+                std::cerr << "Error: " << e.what() << std::endl;
+                return EXIT_INPUT;
+            }
+        default:                     return runSingleCore<LinearAging>(config);
+    }
+}
+
+int BatchRunner::convert(const BatchConfig& config) {
+    TraceWriter writer;
+    if (!writer.open(config.convert_path)) {
+        std::cerr << "Error: cannot write " << config.convert_path << std::endl;
+        return EXIT_INPUT;
+    }
+
+    bool written = true;
+    bool io = false;
+    std::string error;
+    if (!config.trace_path.empty()) {
+        auto add = [&](const TraceRecord& record) {
+            io = io || record.io_interval > 0;
+            written = writer.write(record) && written;
+        };
+        if (!loadTrace(config, add, error)) {
+            std::cerr << "Error: " << error << std::endl;
+            return EXIT_INPUT;
+        }
+    } else {
+        WorkloadGenerator generator(config.workload, config.load_threads);
+        TraceRecord record;
+        while (generator.next(record)) {
+            io = io || record.io_interval > 0;
+            written = writer.write(record) && written;
+        }
+    }
+    if (io) {
+        writer.close();
+        std::remove(config.convert_path.c_str());
+        std::cerr << "Error: binary traces hold CPU-bound processes only (no I/O)" << std::endl;
+        return EXIT_INPUT;
+    }
+
+    uint64_t count = writer.getCount();
+    if (!writer.close() || !written) {
+        std::cerr << "Error: cannot write " << config.convert_path << std::endl;
+        return EXIT_INPUT;
+    }
+    std::cout << "Wrote " << count << " records to " << config.convert_path << std::endl;
+    return EXIT_OK;
+}
+
+int BatchRunner::sweep(const BatchConfig& config) {
+    if (config.cores > 1) {
+        std::cerr << "Error: --sweep runs single-core schedules" << std::endl;
+        return EXIT_USAGE;
+    }
+    if (config.aging_rule != AgingRule::Linear) {
+        std::cerr << "Error: --sweep uses linear aging" << std::endl;
+        return EXIT_USAGE;
+    }
+    if (config.queue_capacity > 0) {
+        std::cerr << "Error: --sweep uses unbounded queues" << std::endl;
+        return EXIT_USAGE;
+    }
+    if (!config.telemetry_path.empty() || config.gantt || !config.chrome_trace_path.empty() ||
+        config.per_process) {
+        std::cerr << "Error: --sweep prints one summary row per grid point (no --telemetry, "
+                     "--gantt, --chrome-trace or --per-process)" << std::endl;
+        return EXIT_USAGE;
+    }
+
+    ParameterSweep sweep(config.sweep_threads);
+    std::string error;
+
+    // Workloads are loaded once; every grid point streams them read-only
+    auto addTrace = [&](const std::string& path) {
+        BatchConfig trace_config = config;
+        trace_config.trace_path = path;
+        std::vector<TraceRecord> records;
+        auto add = [&records](const TraceRecord& record) {
+            records.push_back(record);
+        };
+        if (!loadTrace(trace_config, add, error)) {
+            return false;
+        }
+        sweep.addWorkload(path, std::move(records));
+        return true;
+    };
+    auto addGenerated = [&](uint64_t seed) {
+        WorkloadSpec spec = config.workload;
+        spec.seed = seed;
+        WorkloadGenerator generator(spec, config.load_threads);
+        std::vector<TraceRecord> records;
+        records.reserve(static_cast<size_t>(spec.count));
+        TraceRecord record;
+        while (generator.next(record)) {
+            records.push_back(record);
+        }
+        sweep.addWorkload("seed-" + std::to_string(seed), std::move(records));
+    };
+
+    for (const auto& path : config.sweep_traces) {
+        if (!addTrace(path)) {
+            std::cerr << "Error: " << error << std::endl;
+            return EXIT_INPUT;
+        }
+    }
+    for (uint64_t seed : config.sweep_seeds) {
+        addGenerated(seed);
+    }
+    if (config.sweep_traces.empty() && config.sweep_seeds.empty()) {
+        if (!config.trace_path.empty()) {
+            if (!addTrace(config.trace_path)) {
+                std::cerr << "Error: " << error << std::endl;
+                return EXIT_INPUT;
+            }
+        } else {
+            addGenerated(config.workload.seed);
+        }
+    }
+
+    std::vector<SweepPolicy> policies = config.sweep_policies;
+    if (policies.empty()) {
+        SweepPolicy policy;
+        policy.name = !config.preemptive       ? "nonpreemptive"
+                    : config.time_quantum == 0 ? "preemptive"
+                    : "preemptive-q" + std::to_string(config.time_quantum);
+        SweepPolicy::parse(policy.name, policy);
+        policies.push_back(policy);
+    }
+    for (auto& policy : policies) {
+        policy.aging_mode = config.aging_mode;
+        policy.backend = config.backend;
+        sweep.addPolicy(policy);
+    }
+    for (double factor : config.sweep_factors) {
+        sweep.addAgingFactor(factor);
+    }
+
+    std::vector<SweepResult> results = sweep.run();
+    switch (config.format) {
+        case OutputFormat::Text: ParameterSweep::writeText(std::cout, results); break;
+        case OutputFormat::Json: ParameterSweep::writeJson(std::cout, results); break;
+        case OutputFormat::Csv:  ParameterSweep::writeCsv(std::cout, results); break;
+    }
+    return EXIT_OK;
+}
+
+int BatchRunner::main(int argc, char* argv[]) {
+    BatchConfig config;
+    std::string error;
+    bool show_help;
+
+    if (!parseArguments(argc, argv, config, error, show_help)) {
+        std::cerr << "Error: " << error << std::endl;
+        std::cerr << "Run '" << argv[0] << " --help' for usage." << std::endl;
+        return EXIT_USAGE;
+    }
+    if (show_help) {
+        printUsage(std::cout, argv[0]);
+        return EXIT_OK;
+    }
+    return run(config);
+}
+
+void BatchRunner::printUsage(std::ostream& out, const char* program) {
+    out << "Usage: " << program << " [options]\n"
+        << "       " << program << "            (no options: interactive menu)\n"
+        << "\n"
+        << "Workload (one required):\n"
+        << "  --trace FILE            CSV lines (id,priority,arrival,burst[,io_interval,\n"
+        << "                          io_time]) or binary trace; streamed on a single\n"
+        << "                          core (I/O columns need a single core)\n"
+        << "  --trace-format FORMAT   auto (default), csv or binary\n"
+        << "  --random COUNT          Generated processes\n"
+        << "  --load-threads N        Trace parsing / generation threads (0 = auto)\n"
+        << "\n"
+        << "Generated workload (same seed and options = same workload):\n"
+        << "  --seed N                Random seed (default 1)\n"
+        << "  --arrivals PATTERN      uniform (default), poisson or bursty\n"
+        << "  --max-arrival N         Uniform: arrivals spread over 0..N (default 20)\n"
+        << "  --mean-interarrival F   Poisson/bursty: mean gap between arrivals (default 5)\n"
+        << "  --burst-rate F          Bursty: rate multiplier inside bursts (default 10)\n"
+        << "  --burst-share F         Bursty: share of jobs arriving in bursts (default 0.2)\n"
+        << "  --burst-length F        Bursty: mean jobs per burst (default 50)\n"
+        << "  --burst-dist DIST       Execution times: uniform (default) or pareto\n"
+        << "  --min-burst N           Execution time lower bound (default 1)\n"
+        << "  --max-burst N           Execution time upper bound / cap (default 10)\n"
+        << "  --pareto-alpha F        Pareto tail index (default 1.5)\n"
+        << "  --max-priority N        Priority range 1..N (default 10)\n"
+        << "  --priority-skew F       Zipf skew: 0 uniform, > 0 mostly low urgency,\n"
+        << "                          < 0 mostly urgent (default 0)\n"
+        << "  --io-share F            Share of jobs alternating CPU and I/O bursts,\n"
+        << "                          single core (default 0)\n"
+        << "  --io-interval N         CPU between I/O requests: 1..N per job (default 4)\n"
+        << "  --io-time N             I/O burst length: 1..N per job (default 20)\n"
+        << "\n"
+        << "Policy:\n"
+        << "  --aging F               Aging factor (default 0.1)\n"
+        << "  --aging-policy NAME     linear (default), exponential, step (every 10\n"
+        << "                          time units), capped (at most 5 levels) or fixed;\n"
+        << "                          step and capped are always eager on a heap;\n"
+        << "                          fixed is linear on exact integer keys (lazy)\n"
+        << "  --aging-mode MODE       lazy (default) or eager, single core\n"
+        << "  --backend NAME          heap (default) or bucket, single core\n"
+        << "  --preemptive            Preempt on higher-priority arrival, single core\n"
+        << "  --quantum N             Time quantum in preemptive mode (0 = none)\n"
+        << "  --capacity N            Ready queue bound, single core (0 = unbounded)\n"
+        << "  --overflow POLICY       At capacity: reject (default) the arrival, evict\n"
+        << "                          the least urgent, or backpressure (hold arrivals\n"
+        << "                          back until a place frees)\n"
+        << "  --cores N               Simulated cores; N > 1 enables work stealing\n"
+        << "  --sync-interval N       Multi-core epoch length (default 10)\n"
+        << "  --migration-cost N      Multi-core steal cost (default 1)\n"
+        << "  --host-threads N        Multi-core host threads (0 = auto)\n"
+        << "\n"
+        << "Output:\n"
+        << "  --format FORMAT         text (default), json or csv\n"
+        << "  --per-process           Also print per-process results\n"
+        << "  --convert FILE          Write the workload as a binary trace and exit\n"
+        << "  --gantt                 Also print a Gantt chart of the run (text output)\n"
+        << "  --chrome-trace FILE     Write execution slices as Chrome/Perfetto trace JSON\n"
+        << "  --telemetry FILE        Write periodic queue/CPU samples as CSV (single core)\n"
+        << "  --telemetry-interval N  Time units between samples (default 100)\n"
+        << "  --telemetry-capacity N  Samples kept, newest win (default 4096)\n"
+        << "\n"
+        << "Parameter sweep (single core, one result row per grid point):\n"
+        << "  --sweep FACTORS         Aging factors: 0,0.05,0.1 or start:stop:step\n"
+        << "  --sweep-policies LIST   nonpreemptive, preemptive, preemptive-qN\n"
+        << "                          (default: the policy options above)\n"
+        << "  --sweep-traces LIST     Trace files, one workload each\n"
+        << "  --sweep-seeds LIST      Generated workloads, one per seed\n"
+        << "  --sweep-threads N       Worker threads (0 = auto)\n"
+        << "\n"
+        << "  --config FILE           key=value lines using the option names above\n"
+        << "                          (e.g. aging=0.2); flags override the file\n"
+        << "  --help                  Show this help\n";
+}
@@ -0,0 +1,117 @@
+#include "ConcurrentPriorityQueue.h"
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <thread>
+
+namespace {
+
+constexpr double EMPTY_KEY = std::numeric_limits<double>::infinity();
+
+// Per-thread xorshift generator: cheap and free of shared state
+uint64_t nextRandom() {
+    thread_local uint64_t state =
+        std::hash<std::thread::id>()(std::this_thread::get_id()) | 1;
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+}
+
+ConcurrentPriorityQueue::Shard::Shard() : top_key(EMPTY_KEY) {
+}
+
+void ConcurrentPriorityQueue::Shard::publishTop() {
+    top_key.store(heap.empty() ? EMPTY_KEY : heap.top().key, std::memory_order_release);
+}
+
+ConcurrentPriorityQueue::ConcurrentPriorityQueue(int threads, int shards_per_thread,
+                                                 double aging_factor)
+    : aging_factor(aging_factor), current_time(0), count(0), aging_events(0) {
+    int shard_count = std::max(1, threads * shards_per_thread);
+    shards.reserve(shard_count);
+    for (int i = 0; i < shard_count; i++) {
+        shards.push_back(std::make_unique<Shard>());
+    }
+}
+
+size_t ConcurrentPriorityQueue::randomShard() const {
+    return static_cast<size_t>(nextRandom() % shards.size());
+}
+
+double ConcurrentPriorityQueue::agingKey(const Process* process) const {
+    long long ready_origin = process->getReadyOrigin();
+    return process->getBasePriority() + ready_origin * aging_factor;
+}
+
+void ConcurrentPriorityQueue::insert(Process* process) {
+    if (!process) return;
+
+    double key = agingKey(process);
+
+    // Try a few random shards without blocking, then wait on the last one
+    Shard* shard = shards[randomShard()].get();
+    std::unique_lock<std::mutex> guard(shard->lock, std::try_to_lock);
+    for (int attempt = 0; !guard.owns_lock() && attempt < 4; attempt++) {
+        shard = shards[randomShard()].get();
+        guard = std::unique_lock<std::mutex>(shard->lock, std::try_to_lock);
+    }
+    if (!guard.owns_lock()) {
+        guard.lock();
+    }
+
+    shard->heap.push(key, process);
+    shard->publishTop();
+    count.fetch_add(1, std::memory_order_release);
+}
+
+Process* ConcurrentPriorityQueue::extractMin() {
+    while (count.load(std::memory_order_acquire) > 0) {
+        // Pick two random shards and take the one with the better top
+        Shard* a = shards[randomShard()].get();
+        Shard* b = shards[randomShard()].get();
+        double key_a = a->top_key.load(std::memory_order_acquire);
+        double key_b = b->top_key.load(std::memory_order_acquire);
+        Shard* shard = key_a <= key_b ? a : b;
+
+        if (std::min(key_a, key_b) == EMPTY_KEY) {
+            // Both samples empty: the queue is nearly drained, scan for any
+            // non-empty shard instead of sampling forever
+            shard = nullptr;
+            double best = EMPTY_KEY;
+            for (auto& candidate : shards) {
+                double key = candidate->top_key.load(std::memory_order_acquire);
+                if (key < best) {
+                    best = key;
+                    shard = candidate.get();
+                }
+            }
+            if (!shard) {
+                std::this_thread::yield();
+                continue;
+            }
+        }
+
+        std::unique_lock<std::mutex> guard(shard->lock, std::try_to_lock);
+        if (!guard.owns_lock() || shard->heap.empty()) {
+            continue;
+        }
+
+        Process* process = shard->heap.pop().payload;
+        shard->publishTop();
+        count.fetch_sub(1, std::memory_order_release);
+        guard.unlock();
+
+        // The waiting time recorded at the last removal is where this stay began
+        long long now = current_time.load(std::memory_order_relaxed);
+        long long waited_before = process->getWaitingTime();
+        process->updateEffectivePriority(now, aging_factor);
+        aging_events.fetch_add(process->agingEventsSince(waited_before, aging_factor),
+                               std::memory_order_relaxed);
+        return process;
+    }
+    return nullptr;
+}
@@ -0,0 +1,42 @@
+#include "ExecutionLog.h"
+#include <algorithm>
+#include <ostream>
+
+void ExecutionLog::merge(const ExecutionLog& other) {
+    size_t middle = slices.size();
+    slices.insert(slices.end(), other.slices.begin(), other.slices.end());
+    std::inplace_merge(slices.begin(), slices.begin() + middle, slices.end(),
+                       [](const ExecutionSlice& a, const ExecutionSlice& b) {
+                           return a.start != b.start ? a.start < b.start : a.core < b.core;
+                       });
+}
+
+long long ExecutionLog::getEndTime() const {
+    long long end = 0;
+    for (const auto& slice : slices) {
+        end = std::max(end, slice.end);
+    }
+    return end;
+}
+
+void ExecutionLog::writeChromeTrace(std::ostream& out) const {
+    int cores = 0;
+    for (const auto& slice : slices) {
+        cores = std::max(cores, slice.core + 1);
+    }
+
+    out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+    out << "{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 1, \"args\": {\"name\": \"Scheduler\"}}";
+    for (int core = 0; core < cores; core++) {
+        out << ",\n{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << core
+            << ", \"args\": {\"name\": \"Core " << core << "\"}}";
+    }
+    for (const auto& slice : slices) {
+        out << ",\n{\"name\": \"P" << slice.process_id << "\", \"cat\": \"process\", \"ph\": \"X\""
+            << ", \"pid\": 1, \"tid\": " << slice.core
+            << ", \"ts\": " << slice.start << ", \"dur\": " << slice.end - slice.start
+            << ", \"args\": {\"id\": " << slice.process_id << "}}";
+    }
+    out << "\n]}\n";
+    out.flush();
+}
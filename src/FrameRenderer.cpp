@@ -0,0 +1,152 @@
+#include "FrameRenderer.h"
+#include "Visualizer.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+
+namespace {
+
+const int WIDTH = 60;
+
+const char* const HIDE_CURSOR = "\x1b[?25l";
+const char* const SHOW_CURSOR = "\x1b[?25h";
+const char* const CLEAR_SCREEN = "\x1b[H\x1b[2J";
+const char* const CLEAR_TO_EOL = "\x1b[K";
+const char* const CLEAR_BELOW = "\x1b[J";
+
+void moveTo(std::string& frame, size_t row) {
+    frame += "\x1b[";
+    frame += std::to_string(row + 1);
+    frame += ";1H";
+}
+
+// Left-aligned in width columns
+std::string column(const std::string& text, size_t width) {
+    return text.size() >= width ? text + " " : text + std::string(width - text.size(), ' ');
+}
+
+std::string fixed2(double value) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.2f", value);
+    return text;
+}
+
+}
+
+FrameRenderer::FrameRenderer(int max_fps) : FrameRenderer(max_fps, std::cout) {
+}
+
+FrameRenderer::FrameRenderer(int max_fps, std::ostream& out)
+    : active(false), max_fps(std::max(1, max_fps)), out(out) {
+}
+
+FrameRenderer::~FrameRenderer() {
+    stop();
+}
+
+void FrameRenderer::start() {
+    if (thread.joinable()) {
+        return;
+    }
+    Visualizer::enableAnsi();
+    shown.clear();
+    out << HIDE_CURSOR << CLEAR_SCREEN;
+    out.flush();
+    active.store(true, std::memory_order_release);
+    thread = std::thread(&FrameRenderer::renderLoop, this);
+}
+
+void FrameRenderer::stop() {
+    if (!thread.joinable()) {
+        return;
+    }
+    active.store(false, std::memory_order_release);
+    thread.join();
+    // Leave the cursor below the final frame
+    out << SHOW_CURSOR << '\n';
+    out.flush();
+}
+
+void FrameRenderer::renderLoop() {
+    auto period = std::chrono::microseconds(1000000 / max_fps);
+    auto next = std::chrono::steady_clock::now();
+    while (true) {
+        bool last = !active.load(std::memory_order_acquire);
+        if (buffer.update()) {
+            draw(buffer.readBuffer());
+        }
+        if (last) {
+            break;
+        }
+        next += period;
+        std::this_thread::sleep_until(next);
+    }
+}
+
+void FrameRenderer::draw(const FrameSnapshot& snapshot) {
+    std::vector<std::string> lines;
+    layout(snapshot, lines);
+
+    // Only rewrite lines that differ from the screen
+    frame.clear();
+    for (size_t row = 0; row < lines.size(); row++) {
+        if (row < shown.size() && shown[row] == lines[row]) {
+            continue;
+        }
+        moveTo(frame, row);
+        frame += lines[row];
+        frame += CLEAR_TO_EOL;
+    }
+    if (lines.size() < shown.size()) {
+        moveTo(frame, lines.size());
+        frame += CLEAR_BELOW;
+    }
+    moveTo(frame, lines.size());
+
+    out.write(frame.data(), static_cast<std::streamsize>(frame.size()));
+    out.flush();
+    shown.swap(lines);
+}
+
+void FrameRenderer::layout(const FrameSnapshot& s, std::vector<std::string>& lines) {
+    std::string rule(WIDTH, '=');
+    std::string thin(WIDTH, '-');
+
+    lines.push_back(rule);
+    lines.push_back(column("  LIVE SCHEDULER VIEW", 40) + "Time: " + std::to_string(s.time));
+    lines.push_back(rule);
+
+    if (s.running_id >= 0) {
+        lines.push_back("  Running: P" + std::to_string(s.running_id) +
+                        " (Base: " + std::to_string(s.running_priority) +
+                        ", Remaining: " + std::to_string(s.running_remaining) + ")");
+    } else {
+        lines.push_back("  CPU Idle");
+    }
+    lines.push_back("  Completed: " + std::to_string(s.completed) +
+                    (s.total > 0 ? "/" + std::to_string(s.total) : std::string()) +
+                    " | Queue Size: " + std::to_string(s.queue_length));
+    lines.push_back(thin);
+
+    lines.push_back("  " + column("ID", 8) + column("Base", 8) + column("Effective", 12) + "Remaining");
+    // Fixed height, so rows below the queue keep their place
+    for (size_t i = 0; i < QUEUE_ROWS; i++) {
+        if (i < s.queue.size()) {
+            const FrameSnapshot::Entry& e = s.queue[i];
+            lines.push_back("  " + column("P" + std::to_string(e.id), 8) +
+                            column(std::to_string(e.base_priority), 8) +
+                            column(fixed2(e.effective_priority), 12) +
+                            std::to_string(e.remaining));
+        } else if (i == s.queue.size() && s.queue.empty()) {
+            lines.push_back("  [Queue is empty]");
+        } else {
+            lines.push_back("");
+        }
+    }
+    int more = s.queue_length - static_cast<int>(s.queue.size());
+    lines.push_back(more > 0 ? "  ... and " + std::to_string(more) + " more" : "");
+    lines.push_back(thin);
+    lines.push_back("  " + s.event);
+    lines.push_back(rule);
+}
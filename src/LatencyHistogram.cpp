@@ -0,0 +1,124 @@
+#include "LatencyHistogram.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+namespace {
+
+// Index of the highest set bit (value > 0)
+int highestBit(unsigned long long value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - __builtin_clzll(value);
+#else
+    int bit = 0;
+    while (value >>= 1) bit++;
+    return bit;
+#endif
+}
+
+}
+
+LatencyHistogram::LatencyHistogram()
+    : total(0), min_value(LLONG_MAX), max_value(0), sum(0.0) {
+}
+
+size_t LatencyHistogram::indexOf(long long value) {
+    if (value < static_cast<long long>(SUB_BUCKETS)) {
+        return static_cast<size_t>(std::max(0LL, value));
+    }
+    // value = sub << shift with sub in [HALF_BUCKETS, SUB_BUCKETS)
+    int shift = highestBit(static_cast<unsigned long long>(value)) - SUB_BUCKET_BITS + 1;
+    size_t sub = static_cast<size_t>(value >> shift);
+    return shift * HALF_BUCKETS + sub;
+}
+
+long long LatencyHistogram::lowestValueAt(size_t index) {
+    if (index < SUB_BUCKETS) {
+        return static_cast<long long>(index);
+    }
+    int shift = static_cast<int>(index / HALF_BUCKETS) - 1;
+    long long sub = static_cast<long long>(index % HALF_BUCKETS + HALF_BUCKETS);
+    return sub << shift;
+}
+
+long long LatencyHistogram::highestValueAt(size_t index) {
+    if (index < SUB_BUCKETS) {
+        return static_cast<long long>(index);
+    }
+    int shift = static_cast<int>(index / HALF_BUCKETS) - 1;
+    return lowestValueAt(index) + (1LL << shift) - 1;
+}
+
+void LatencyHistogram::record(long long value, uint64_t count) {
+    value = std::max(0LL, value);
+    size_t index = indexOf(value);
+    if (index >= counts.size()) {
+        // Grow a whole power of two at a time
+        counts.resize((index / HALF_BUCKETS + 1) * HALF_BUCKETS, 0);
+    }
+    counts[index] += count;
+    total += count;
+    min_value = std::min(min_value, value);
+    max_value = std::max(max_value, value);
+    sum += static_cast<double>(value) * count;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    if (other.counts.size() > counts.size()) {
+        counts.resize(other.counts.size(), 0);
+    }
+    for (size_t i = 0; i < other.counts.size(); i++) {
+        counts[i] += other.counts[i];
+    }
+    total += other.total;
+    min_value = std::min(min_value, other.min_value);
+    max_value = std::max(max_value, other.max_value);
+    sum += other.sum;
+}
+
+void LatencyHistogram::reset() {
+    counts.clear();
+    total = 0;
+    min_value = LLONG_MAX;
+    max_value = 0;
+    sum = 0.0;
+}
+
+long long LatencyHistogram::percentile(double p) const {
+    if (total == 0) {
+        return 0;
+    }
+    // Smallest value with at least p% of samples at or below it
+    uint64_t rank = static_cast<uint64_t>(std::ceil(std::min(100.0, std::max(0.0, p)) / 100.0 * total));
+    rank = std::max<uint64_t>(1, rank);
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < counts.size(); i++) {
+        seen += counts[i];
+        if (seen >= rank) {
+            return std::min(max_value, std::max(min_value, highestValueAt(i)));
+        }
+    }
+    return max_value;
+}
+
+uint64_t LatencyHistogram::countAbove(long long value) const {
+    if (value < 0) {
+        return total;
+    }
+    if (value >= max_value) {
+        return 0;
+    }
+    // Buckets above value, plus the one containing it unless value is its
+    // top: a wide bucket may hold values just above, so it is counted whole
+    // (an overcount within the bucket's width, never an undercount)
+    size_t first = indexOf(value);
+    if (value == highestValueAt(first)) {
+        first++;
+    }
+    uint64_t above = 0;
+    for (size_t i = first; i < counts.size(); i++) {
+        above += counts[i];
+    }
+    return above;
+}
@@ -0,0 +1,364 @@
+#include "MultiCoreScheduler.h"
+#include "Visualizer.h"
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <thread>
+
+namespace {
+
+// Reusable barrier for a fixed number of threads. Epochs can be short, so
+// waiters yield instead of sleeping on a condition variable.
+class EpochBarrier {
+private:
+    const int parties;
+    std::atomic<int> arrived;
+    std::atomic<unsigned> generation;
+
+public:
+    explicit EpochBarrier(int parties) : parties(parties), arrived(0), generation(0) {}
+
+    void wait() {
+        unsigned current = generation.load(std::memory_order_acquire);
+        if (arrived.fetch_add(1, std::memory_order_acq_rel) + 1 == parties) {
+            arrived.store(0, std::memory_order_relaxed);
+            generation.fetch_add(1, std::memory_order_release);
+            return;
+        }
+        while (generation.load(std::memory_order_acquire) == current) {
+            std::this_thread::yield();
+        }
+    }
+};
+
+}
+
+MultiCoreScheduler::Core::Core(int index, double aging_factor)
+    : index(index), queue(aging_factor), next_pending(0), running(nullptr), now(0),
+      available_at(0), busy_time(0), last_completion(0) {
+}
+
+void MultiCoreScheduler::Core::advance(ProcessTable& processes, long long epoch_end) {
+    // Same event loop as Scheduler::run (non-preemptive), bounded by the epoch
+    while (true) {
+        batch.clear();
+        while (next_pending < pending.size() &&
+               processes[pending[next_pending]].getArrivalTime() <= now) {
+            batch.push_back(&processes[pending[next_pending++]]);
+        }
+        queue.insertBatch(batch);
+        if (now >= epoch_end) {
+            break;
+        }
+
+        if (!running) {
+            long long next_time = epoch_end;
+            if (now < available_at) {
+                next_time = std::min(next_time, available_at);
+            } else if (queue.isEmpty()) {
+                if (next_pending < pending.size()) {
+                    next_time = std::min(next_time, processes[pending[next_pending]].getArrivalTime());
+                }
+            } else {
+                queue.applyAging(now);
+                running = queue.extractMin();
+                if (running->getStartTime() == -1) {
+                    running->setStartTime(now);
+                }
+                continue;
+            }
+            now = next_time;
+            continue;
+        }
+
+        long long end = std::min(now + running->getRemainingTime(), epoch_end);
+        running->execute(static_cast<int>(end - now));
+        log.record(running->getId(), index, now, end);
+        busy_time += end - now;
+        now = end;
+
+        if (running->isCompleted()) {
+            queue.applyAging(now);
+            running->setCompletionTime(now);
+            running->setWaitingTime(now - running->getArrivalTime() - running->getBurstTime());
+            completed.push_back(running);
+            last_completion = now;
+            running = nullptr;
+        }
+    }
+    queue.applyAging(now);
+}
+
+MultiCoreScheduler::MultiCoreScheduler(int core_count, double aging_factor, bool verbose)
+    : aging_factor(aging_factor), verbose(verbose), sync_interval(10),
+      migration_cost(1), host_threads(0) {
+    core_count = std::max(1, core_count);
+    for (int i = 0; i < core_count; i++) {
+        cores.push_back(std::make_unique<Core>(i, aging_factor));
+    }
+}
+
+void MultiCoreScheduler::addProcess(const Process& process) {
+    processes.add(process);
+}
+
+void MultiCoreScheduler::addProcess(int id, int priority, long long arrival, int burst) {
+    processes.add(id, priority, arrival, burst);
+}
+
+void MultiCoreScheduler::generateRandomProcesses(int count, int max_priority,
+                                                 int max_arrival, int max_burst, uint64_t seed) {
+    // Uniform arrivals over [0, max_arrival], uniform priorities and bursts
+    WorkloadSpec spec;
+    spec.seed = seed;
+    spec.count = count;
+    spec.arrivals = ArrivalPattern::Uniform;
+    spec.horizon = max_arrival;
+    spec.max_priority = max_priority;
+    spec.max_burst = max_burst;
+    generateWorkload(spec);
+}
+
+void MultiCoreScheduler::generateWorkload(const WorkloadSpec& spec) {
+    // Generated in arrival order, so the table needs no sort
+    WorkloadGenerator(spec).generate(processes);
+}
+
+void MultiCoreScheduler::placeArrivals(uint32_t& next_arrival, long long epoch_end,
+                                       size_t& next_core) {
+    for (auto& core : cores) {
+        core->pending.clear();
+        core->next_pending = 0;
+    }
+    // Round-robin in arrival order, so each core's list stays sorted
+    while (next_arrival < processes.size() &&
+           processes[next_arrival].getArrivalTime() < epoch_end) {
+        cores[next_core]->pending.push_back(next_arrival++);
+        next_core = (next_core + 1) % cores.size();
+    }
+}
+
+void MultiCoreScheduler::collectCompletions(uint32_t& completed) {
+    for (size_t i = 0; i < cores.size(); i++) {
+        for (Process* process : cores[i]->completed) {
+            stats.recordProcess(process);
+            completed++;
+            if (verbose) {
+                std::cout << "  [Core " << i << "] Process " << process->getId()
+                          << " completed at time " << process->getCompletionTime()
+                          << " (Waiting: " << process->getWaitingTime()
+                          << ", Turnaround: " << process->getTurnaroundTime()
+                          << ")" << std::endl;
+            }
+        }
+        cores[i]->completed.clear();
+    }
+}
+
+void MultiCoreScheduler::stealWork(long long now) {
+    // Cores that received work this round are neither thieves nor victims again
+    std::vector<bool> migrated(cores.size(), false);
+
+    for (size_t thief = 0; thief < cores.size(); thief++) {
+        Core& idle_core = *cores[thief];
+        if (!idle_core.idle() || idle_core.available_at > now) {
+            continue;
+        }
+
+        // Victim: the core with the most surplus work (lowest index on ties).
+        // A core that is free to dispatch keeps its own queue head.
+        size_t victim = thief;
+        size_t surplus = 0;
+        for (size_t i = 0; i < cores.size(); i++) {
+            const Core& core = *cores[i];
+            size_t waiting = core.queue.size();
+            if (migrated[i] || waiting == 0) {
+                continue;
+            }
+            bool busy = core.running || core.available_at > now;
+            size_t stealable = busy ? waiting : waiting - 1;
+            if (stealable > surplus) {
+                surplus = stealable;
+                victim = i;
+            }
+        }
+        if (surplus == 0) {
+            return;
+        }
+
+        // Take the most urgent half, so stolen work runs as soon as the
+        // migration completes
+        size_t amount = (surplus + 1) / 2;
+        PriorityQueue& source = cores[victim]->queue;
+        source.applyAging(now);
+        idle_core.queue.applyAging(now);
+        idle_core.batch.clear();
+        source.extractTopK(amount, idle_core.batch);
+        idle_core.queue.insertBatch(idle_core.batch);
+        for (Process* process : idle_core.batch) {
+            stats.recordMigration();
+            if (verbose) {
+                std::cout << "  [Core " << thief << "] Stole process " << process->getId()
+                          << " from core " << victim << " at time " << now << std::endl;
+            }
+        }
+        idle_core.available_at = now + migration_cost;
+        migrated[thief] = true;
+    }
+}
+
+void MultiCoreScheduler::simulateEpochs(int threads) {
+    const uint32_t total = processes.size();
+    uint32_t next_arrival = 0;
+    uint32_t completed = 0;
+    size_t next_core = 0;
+    long long epoch_start = 0;
+    long long epoch_end = 0;
+    std::atomic<bool> stop(false);
+
+    // Cores are split statically: host thread t simulates cores t, t + threads, ...
+    EpochBarrier barrier(threads);
+    auto advanceShare = [this, &epoch_end, threads](int thread) {
+        for (size_t i = thread; i < cores.size(); i += threads) {
+            cores[i]->advance(processes, epoch_end);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int t = 1; t < threads; t++) {
+        workers.emplace_back([&barrier, &stop, &advanceShare, t]() {
+            while (true) {
+                barrier.wait();  // Epoch start
+                if (stop.load(std::memory_order_relaxed)) {
+                    break;
+                }
+                advanceShare(t);
+                barrier.wait();  // Epoch end
+            }
+        });
+    }
+
+    while (completed < total) {
+        // Nothing running or queued anywhere: skip straight to the epoch of
+        // the next arrival
+        bool all_idle = std::all_of(cores.begin(), cores.end(),
+                                    [](const std::unique_ptr<Core>& core) { return core->idle(); });
+        if (all_idle && next_arrival < total) {
+            long long next_time = processes[next_arrival].getArrivalTime();
+            if (next_time >= epoch_start + sync_interval) {
+                epoch_start = next_time - next_time % sync_interval;
+                for (auto& core : cores) {
+                    core->now = std::max(core->now, epoch_start);
+                }
+            }
+        }
+
+        epoch_end = epoch_start + sync_interval;
+        placeArrivals(next_arrival, epoch_end, next_core);
+
+        if (threads > 1) {
+            barrier.wait();
+            advanceShare(0);
+            barrier.wait();
+        } else {
+            advanceShare(0);
+        }
+
+        collectCompletions(completed);
+        stealWork(epoch_end);
+        epoch_start = epoch_end;
+    }
+
+    if (threads > 1) {
+        stop.store(true, std::memory_order_relaxed);
+        barrier.wait();
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void MultiCoreScheduler::run() {
+    if (processes.empty()) {
+        if (verbose) {
+            std::cout << "No processes to schedule!" << std::endl;
+        }
+        return;
+    }
+
+    processes.sortByArrival();
+    stats.setTotalProcesses(processes.size());
+    for (auto& core : cores) {
+        core->log.clear();
+    }
+
+    int threads = host_threads > 0 ? host_threads
+                                   : static_cast<int>(std::thread::hardware_concurrency());
+    threads = std::max(1, std::min(threads, static_cast<int>(cores.size())));
+
+    if (verbose) {
+        Visualizer::printHeader("MULTI-CORE SIMULATION START");
+        std::cout << "Cores: " << cores.size() << ", Host Threads: " << threads << std::endl;
+        std::cout << "Aging Factor: " << aging_factor
+                  << ", Sync Interval: " << sync_interval
+                  << ", Migration Cost: " << migration_cost << std::endl;
+        std::cout << "Total Processes: " << processes.size() << std::endl;
+        Visualizer::printSeparator('-', 60);
+    }
+
+    simulateEpochs(threads);
+
+    long long end_time = 0;
+    long long aging_events = 0;
+    for (const auto& core : cores) {
+        end_time = std::max(end_time, core->last_completion);
+        aging_events += core->queue.getAgingEvents();
+    }
+    stats.setTotalExecutionTime(end_time);
+    stats.recordAgingEvents(aging_events);
+    for (size_t i = 0; i < cores.size(); i++) {
+        stats.setCoreBusyTime(static_cast<int>(i), cores[i]->busy_time);
+    }
+
+    if (verbose) {
+        Visualizer::printSeparator('=', 60);
+        std::cout << "SIMULATION COMPLETED at time " << end_time << std::endl;
+        Visualizer::printSeparator('=', 60);
+    }
+}
+
+void MultiCoreScheduler::enableExecutionLog(bool enabled) {
+    for (auto& core : cores) {
+        core->log.setEnabled(enabled);
+    }
+}
+
+ExecutionLog MultiCoreScheduler::getExecutionLog() const {
+    ExecutionLog log(true);
+    for (const auto& core : cores) {
+        log.merge(core->log);
+    }
+    return log;
+}
+
+void MultiCoreScheduler::displayGanttChart() const {
+    Visualizer::displayGanttChart(getExecutionLog());
+}
+
+std::vector<const Process*> MultiCoreScheduler::getCompletedProcesses() const {
+    std::vector<const Process*> completed;
+    for (uint32_t i = 0; i < processes.size(); i++) {
+        if (processes[i].getCompletionTime() != -1) {
+            completed.push_back(&processes[i]);
+        }
+    }
+    std::stable_sort(completed.begin(), completed.end(),
+                     [](const Process* a, const Process* b) {
+                         return a->getCompletionTime() < b->getCompletionTime();
+                     });
+    return completed;
+}
+
+void MultiCoreScheduler::displayStatistics() const {
+    stats.display();
+}
@@ -0,0 +1,208 @@
+#include "ParameterSweep.h"
+#include "Scheduler.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+namespace {
+
+bool parseNumber(const std::string& text, double& value) {
+    if (text.empty()) return false;
+    char* end = nullptr;
+    errno = 0;
+    value = std::strtod(text.c_str(), &end);
+    return errno == 0 && *end == '\0' && std::isfinite(value) && value >= 0.0;
+}
+
+std::string jsonString(const std::string& text) {
+    std::string out = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out + "\"";
+}
+
+std::string csvField(const std::string& text) {
+    if (text.find_first_of(",\"\n") == std::string::npos) {
+        return text;
+    }
+    std::string out = "\"";
+    for (char c : text) {
+        if (c == '"') out += '"';
+        out += c;
+    }
+    return out + "\"";
+}
+
+}
+
+bool SweepPolicy::parse(std::string text, SweepPolicy& policy) {
+    // text by value: callers may pass policy.name, which is reset below
+    policy = SweepPolicy();
+    policy.name = text;
+    if (text == "nonpreemptive") {
+        return true;
+    }
+    policy.preemptive = true;
+    if (text == "preemptive") {
+        return true;
+    }
+    const std::string prefix = "preemptive-q";
+    if (text.compare(0, prefix.size(), prefix) != 0 || text.size() == prefix.size()) {
+        return false;
+    }
+    std::string quantum = text.substr(prefix.size());
+    if (quantum.find_first_not_of("0123456789") != std::string::npos || quantum.size() > 9) {
+        return false;
+    }
+    policy.time_quantum = std::atoi(quantum.c_str());
+    return policy.time_quantum > 0;
+}
+
+ParameterSweep::ParameterSweep(int threads) : threads(0) {
+    setThreads(threads);
+}
+
+void ParameterSweep::setThreads(int count) {
+    threads = count > 0 ? count : std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+}
+
+void ParameterSweep::addWorkload(const std::string& name, std::vector<TraceRecord> records) {
+    // Sorted once here so every run can stream it in arrival order
+    std::stable_sort(records.begin(), records.end(),
+                     [](const TraceRecord& a, const TraceRecord& b) { return a.arrival < b.arrival; });
+    workloads.push_back({name, std::move(records)});
+}
+
+SweepResult ParameterSweep::runPoint(size_t index) const {
+    size_t factor = index % factors.size();
+    size_t policy = index / factors.size() % policies.size();
+    size_t workload = index / factors.size() / policies.size();
+
+    const SweepPolicy& p = policies[policy];
+    Scheduler scheduler(factors[factor], false);
+    scheduler.setAgingMode(p.aging_mode);
+    scheduler.setQueueBackend(p.backend);
+    scheduler.setPreemptive(p.preemptive, p.time_quantum);
+
+    RecordSource source(workloads[workload].records);
+    scheduler.setWorkloadSource(&source);
+    scheduler.run();
+
+    return {workloads[workload].name, p.name, factors[factor], scheduler.getStatistics()};
+}
+
+std::vector<SweepResult> ParameterSweep::run() const {
+    std::vector<SweepResult> results(size());
+
+    // Workers claim grid points from a shared counter; each result goes to
+    // its grid slot, so scheduling order never shows in the output
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        for (size_t i = next++; i < results.size(); i = next++) {
+            results[i] = runPoint(i);
+        }
+    };
+
+    int count = static_cast<int>(std::min<size_t>(threads, results.size()));
+    std::vector<std::thread> pool;
+    for (int t = 1; t < count; t++) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    return results;
+}
+
+bool ParameterSweep::parseFactors(const std::string& text, std::vector<double>& factors) {
+    factors.clear();
+
+    // Range: count the steps so rounding cannot add or drop the endpoint
+    if (text.find(':') != std::string::npos) {
+        std::stringstream ss(text);
+        std::string start_text, stop_text, step_text, extra;
+        double start, stop, step;
+        if (!std::getline(ss, start_text, ':') || !std::getline(ss, stop_text, ':') ||
+            !std::getline(ss, step_text, ':') || std::getline(ss, extra, ':') ||
+            !parseNumber(start_text, start) || !parseNumber(stop_text, stop) ||
+            !parseNumber(step_text, step) || step <= 0.0 || stop < start) {
+            return false;
+        }
+        long long steps = static_cast<long long>(std::floor((stop - start) / step + 1e-9));
+        if (steps > 100000) {
+            return false;
+        }
+        for (long long i = 0; i <= steps; i++) {
+            factors.push_back(start + i * step);
+        }
+        return true;
+    }
+
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        double factor;
+        if (!parseNumber(item, factor)) {
+            return false;
+        }
+        factors.push_back(factor);
+    }
+    return !factors.empty();
+}
+
+void ParameterSweep::writeText(std::ostream& out, const std::vector<SweepResult>& results) {
+    out << std::left << std::setw(20) << "Workload"
+        << std::setw(18) << "Policy"
+        << std::right << std::setw(8) << "Aging"
+        << std::setw(12) << "Avg Wait"
+        << std::setw(12) << "Max Wait"
+        << std::setw(16) << "Avg Turnaround"
+        << std::setw(10) << "CPU %"
+        << std::setw(14) << "Aging Events"
+        << std::setw(13) << "Preemptions" << std::endl;
+    out << std::string(123, '-') << std::endl;
+
+    for (const auto& r : results) {
+        out << std::left << std::setw(20) << r.workload
+            << std::setw(18) << r.policy
+            << std::right << std::setw(8) << std::defaultfloat << r.aging_factor
+            << std::fixed << std::setprecision(2)
+            << std::setw(12) << r.stats.getAverageWaitingTime()
+            << std::setw(12) << r.stats.getMaxWaitingTime()
+            << std::setw(16) << r.stats.getAverageTurnaroundTime()
+            << std::setw(10) << r.stats.getCpuUtilization()
+            << std::setw(14) << r.stats.getTotalAgingEvents()
+            << std::setw(13) << r.stats.getPreemptions() << std::endl;
+        out << std::defaultfloat << std::setprecision(6);
+    }
+}
+
+void ParameterSweep::writeCsv(std::ostream& out, const std::vector<SweepResult>& results) {
+    out << "workload,policy,aging_factor," << Statistics::csvHeader() << std::endl;
+    for (const auto& r : results) {
+        out << csvField(r.workload) << ',' << csvField(r.policy) << ','
+            << r.aging_factor << ',' << r.stats.toCsvRow() << std::endl;
+    }
+}
+
+void ParameterSweep::writeJson(std::ostream& out, const std::vector<SweepResult>& results) {
+    out << "{\"results\": [" << std::endl;
+    for (size_t i = 0; i < results.size(); i++) {
+        const SweepResult& r = results[i];
+        out << "  {\"workload\": " << jsonString(r.workload)
+            << ", \"policy\": " << jsonString(r.policy)
+            << ", \"aging_factor\": " << r.aging_factor
+            << ", \"statistics\": " << r.stats.toJson() << "}"
+            << (i + 1 < results.size() ? "," : "") << std::endl;
+    }
+    out << "]}" << std::endl;
+}
@@ -1,139 +1,671 @@
 #include "PriorityQueue.h"
+#include "AgingKernel.h"
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+// Credits the heap work done during its lifetime to one operation; empty
+// unless the queue is instrumented
+class OpScope {
+private:
+    QueueOpStats::Op& op;
+    const HeapOpCounts& counts;
+    HeapOpCounts before;
+
+public:
+    OpScope(QueueOpStats::Op& op, const HeapOpCounts& counts) : op(op), counts(counts) {
+        if constexpr (QUEUE_INSTRUMENTED) {
+            before = counts;
+        }
+    }
+    ~OpScope() {
+        if constexpr (QUEUE_INSTRUMENTED) {
+            op.calls++;
+            op.comparisons += counts.comparisons - before.comparisons;
+            op.swaps += counts.swaps - before.swaps;
+            op.levels += counts.levels - before.levels;
+        }
+    }
+};
+
+// Adds its lifetime to a nanosecond total; empty unless instrumented
+class TimeScope {
+private:
+    uint64_t& total;
+    std::chrono::steady_clock::time_point start;
+
+public:
+    explicit TimeScope(uint64_t& total) : total(total) {
+        if constexpr (QUEUE_INSTRUMENTED) {
+            start = std::chrono::steady_clock::now();
+        }
+    }
+    ~TimeScope() {
+        if constexpr (QUEUE_INSTRUMENTED) {
+            total += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count();
+        }
+    }
+};
 
-PriorityQueue::PriorityQueue(double aging_factor)
-    : aging_factor(aging_factor), current_time(0), aging_events(0) {
 }
 
-PriorityQueue::~PriorityQueue() {
+template <typename Policy>
+BasicPriorityQueue<Policy>::BasicPriorityQueue(double aging_factor, AgingMode mode, QueueBackend backend)
+    : heap(EntryOrder{this}), buckets(EntryOrder{this}),
+      backend(Policy::ORDER_INVARIANT ? backend : QueueBackend::Heap),
+      capacity(0), overflow(OverflowPolicy::Reject), shed_heap(ShedOrder{EntryOrder{this}}),
+      next_sequence(0), ids_indexed(false), aging_factor(aging_factor), mode(supportedMode(mode)),
+      current_time(0), aging_events(0), max_key(LOWEST_KEY), max_key_stale(false) {
 }
 
-bool PriorityQueue::hasHigherPriority(int i, int j) const {
-    if (i >= heap.size() || j >= heap.size()) {
-        return false;
+template <typename Policy>
+BasicPriorityQueue<Policy>::~BasicPriorityQueue() {
+}
+
+template <typename Policy>
+typename BasicPriorityQueue<Policy>::Key BasicPriorityQueue<Policy>::agingKey(const Process* process) const {
+    // Linear: effective = base - (t - arrival - executed) * factor
+    //                  = key - t * factor, so for a fixed t the order by key
+    // is the order by effective priority. Entries clamped at 0 tie on
+    // effective priority; the key then puts the one that reached the floor
+    // first at the front.
+    long long ready_origin = process->getReadyOrigin();
+    return Policy::key(process->getBasePriority(), ready_origin, aging_factor);
+}
+
+// FIXED_POINT: a key past the packed width would lose its high bits and
+// silently reorder the queue, so refuse it
+template <typename Policy>
+void BasicPriorityQueue<Policy>::checkKey(int base_priority, const Process* process) const {
+    if constexpr (FIXED_POINT) {
+        if (!Policy::fits(base_priority, process->getReadyOrigin(), aging_factor)) {
+            throw std::overflow_error("fixed-point aging key of process " +
+                                      std::to_string(process->getId()) + " (priority " +
+                                      std::to_string(base_priority) + ", ready since " +
+                                      std::to_string(process->getReadyOrigin()) +
+                                      ") does not fit in 40 bits");
+        }
+    }
+}
+
+template <typename Policy>
+typename BasicPriorityQueue<Policy>::Key BasicPriorityQueue<Policy>::heapKey(uint32_t slot) const {
+    if constexpr (FIXED_POINT) {
+        // Always Lazy: the exact key, ties settled by insertion order
+        return Policy::pack(agingKey(slots[slot]), slot_sequence[slot]);
+    } else {
+        if constexpr (Policy::ORDER_INVARIANT) {
+            if (mode == AgingMode::Lazy || backend == QueueBackend::Bucket) {
+                return agingKey(slots[slot]);
+            }
+        }
+        if constexpr (BULK_AGING) {
+            return slot_effective[slot];
+        }
+        return slots[slot]->getEffectivePriority();
     }
-    return heap[i]->getEffectivePriority() < heap[j]->getEffectivePriority();
 }
 
-void PriorityQueue::swap(int i, int j) {
-    if (i < heap.size() && j < heap.size()) {
-        std::swap(heap[i], heap[j]);
+template <typename Policy>
+bool BasicPriorityQueue<Policy>::breaksTie(uint32_t a, uint32_t b) const {
+    // Ties are broken by aging key, then arrival, then id, so the order is
+    // total and the next process does not depend on heap layout or on how
+    // often aging was applied. Both modes apply the same tie-break; which
+    // entries tie can differ by rounding (see AgingMode).
+    const Process* pa = slots[a];
+    const Process* pb = slots[b];
+
+    if (mode == AgingMode::Eager) {
+        Key key_a = agingKey(pa);
+        Key key_b = agingKey(pb);
+        if (key_a != key_b) {
+            return key_a < key_b;
+        }
+    }
+    if (pa->getArrivalTime() != pb->getArrivalTime()) {
+        return pa->getArrivalTime() < pb->getArrivalTime();
     }
+    return pa->getId() < pb->getId();
 }
 
-void PriorityQueue::heapifyUp(int index) {
-    while (index > 0 && hasHigherPriority(index, parent(index))) {
-        swap(index, parent(index));
-        index = parent(index);
+template <typename Policy>
+void BasicPriorityQueue<Policy>::pushEntry(uint32_t slot) {
+    if (backend == QueueBackend::Heap) {
+        heap.push(heapKey(slot), slot);
+    } else {
+        buckets.push(slots[slot]->getBasePriority(), heapKey(slot), slot);
+    }
+    if (tracksLowest()) {
+        shed_heap.push(heapKey(slot), slot);
     }
 }
 
-void PriorityQueue::heapifyDown(int index) {
-    int smallest = index;
-    int left = leftChild(index);
-    int right = rightChild(index);
+template <typename Policy>
+uint32_t BasicPriorityQueue<Policy>::topEntry() const {
+    return backend == QueueBackend::Heap ? heap.top().payload : buckets.top().payload;
+}
 
-    if (left < heap.size() && hasHigherPriority(left, smallest)) {
-        smallest = left;
+template <typename Policy>
+uint32_t BasicPriorityQueue<Policy>::popEntry() {
+    uint32_t slot = backend == QueueBackend::Heap ? heap.pop().payload : buckets.pop().payload;
+    if (tracksLowest()) {
+        shed_heap.erase(slot);
     }
+    return slot;
+}
 
-    if (right < heap.size() && hasHigherPriority(right, smallest)) {
-        smallest = right;
+template <typename Policy>
+void BasicPriorityQueue<Policy>::eraseEntry(uint32_t slot) {
+    if (backend == QueueBackend::Heap) {
+        heap.erase(slot);
+    } else {
+        buckets.erase(slot);
+    }
+    if (tracksLowest()) {
+        shed_heap.erase(slot);
     }
+}
 
-    if (smallest != index) {
-        swap(index, smallest);
-        heapifyDown(smallest);
+template <typename Policy>
+void BasicPriorityQueue<Policy>::updateEntry(uint32_t slot) {
+    if (backend == QueueBackend::Heap) {
+        heap.update(slot, heapKey(slot));
+    } else {
+        buckets.update(slot, slots[slot]->getBasePriority(), heapKey(slot));
+    }
+    if (tracksLowest()) {
+        shed_heap.update(slot, heapKey(slot));
     }
 }
 
-void PriorityQueue::insert(Process* process) {
+template <typename Policy>
+template <typename Fn>
+void BasicPriorityQueue<Policy>::forEachEntry(Fn fn) const {
+    // Heap array order, or level by level for buckets
+    if (backend == QueueBackend::Heap) {
+        for (size_t i = 0; i < heap.size(); i++) {
+            fn(heap[i].payload);
+        }
+    } else {
+        buckets.forEach([&fn](const typename EntryBuckets::Node& node) { fn(node.payload); });
+    }
+}
+
+template <typename Policy>
+void BasicPriorityQueue<Policy>::observe(Process* process) const {
+    // Lazy keys and bulk aging leave the process itself behind
+    if (mode == AgingMode::Lazy || bulkAging()) {
+        process->template updateEffectivePriority<Policy>(current_time, aging_factor);
+    }
+}
+
+template <typename Policy>
+void BasicPriorityQueue<Policy>::countAgingEvents(Process* process, long long waited_before) {
+    // Counted when the process leaves the queue, over the waiting accrued
+    // during this stay, so the total does not depend on how often
+    // applyAging() ran or how many times a preempted process was requeued.
+    process->template updateEffectivePriority<Policy>(current_time, aging_factor);
+    aging_events += process->template agingEventsSince<Policy>(waited_before, aging_factor);
+}
+
+// FIXED_POINT: checks the keys of the processes about to be inserted and
+// reserves a sequence number for each, before any of them takes a slot, so
+// a renumbering never misses part of a batch
+template <typename Policy>
+void BasicPriorityQueue<Policy>::reserveSequences(Process* const* processes, size_t count) {
+    if constexpr (FIXED_POINT) {
+        size_t admitted = 0;
+        for (size_t i = 0; i < count; i++) {
+            if (processes[i]) {
+                checkKey(processes[i]->getBasePriority(), processes[i]);
+                admitted++;
+            }
+        }
+        if (static_cast<size_t>(size()) + admitted > Policy::SEQUENCE_LIMIT) {
+            throw std::overflow_error("fixed-point queue holds at most " +
+                                      std::to_string(Policy::SEQUENCE_LIMIT) + " processes");
+        }
+        if (next_sequence + admitted > Policy::SEQUENCE_LIMIT) {
+            renumberSequences();
+        }
+    }
+}
+
+template <typename Policy>
+uint32_t BasicPriorityQueue<Policy>::acquireSlot(Process* process, long long waited_before) {
+    uint32_t slot;
+    if (free_slots.empty()) {
+        slot = static_cast<uint32_t>(slots.size());
+        slots.push_back(process);
+        slot_waited.push_back(waited_before);
+    } else {
+        slot = free_slots.back();
+        free_slots.pop_back();
+        slots[slot] = process;
+        slot_waited[slot] = waited_before;
+    }
+    if (ids_indexed) {
+        slot_of[process->getId()] = slot;
+    }
+    if (bulkAging()) {
+        if (slot == slot_origin.size()) {
+            slot_origin.push_back(0.0);
+            slot_base.push_back(0.0);
+            slot_effective.push_back(0.0);
+        }
+        slot_origin[slot] = static_cast<double>(process->getReadyOrigin());
+        slot_base[slot] = process->getBasePriority();
+        slot_effective[slot] = process->getEffectivePriority();
+    }
+    if constexpr (FIXED_POINT) {
+        if (slot == slot_sequence.size()) {
+            slot_sequence.push_back(0);
+        }
+        slot_sequence[slot] = next_sequence++;
+    }
+    return slot;
+}
+
+template <typename Policy>
+Process* BasicPriorityQueue<Policy>::releaseSlot(uint32_t slot) {
+    Process* process = slots[slot];
+    if (agingKey(process) >= max_key) {
+        max_key_stale = true;
+    }
+    slots[slot] = nullptr;
+    free_slots.push_back(slot);
+    if (ids_indexed) {
+        slot_of.erase(process->getId());
+    }
+    if (bulkAging()) {
+        slot_origin[slot] = HUGE_VAL;
+    }
+
+    countAgingEvents(process, slot_waited[slot]);
+    return process;
+}
+
+template <typename Policy>
+void BasicPriorityQueue<Policy>::insert(Process* process) {
+    OpScope scope(op_stats.insert, heap.counts());
     if (!process) return;
+    reserveSequences(&process, 1);
 
-    process->updateEffectivePriority(current_time, aging_factor);
-    heap.push_back(process);
-    heapifyUp(heap.size() - 1);
+    // Waiting does not accrue while a process runs, so the value recorded at
+    // its last removal (0 for a new arrival) is where this stay starts
+    long long waited_before = process->getWaitingTime();
+    process->template updateEffectivePriority<Policy>(current_time, aging_factor);
+    pushEntry(acquireSlot(process, waited_before));
+    if (!max_key_stale) {
+        max_key = std::max(max_key, agingKey(process));
+    }
 }
 
-Process* PriorityQueue::extractMin() {
+template <typename Policy>
+Process* BasicPriorityQueue<Policy>::extractMin() {
     if (isEmpty()) {
         return nullptr;
     }
 
-    Process* minProcess = heap[0];
+    OpScope scope(op_stats.extract_min, heap.counts());
+    return releaseSlot(popEntry());
+}
 
-    heap[0] = heap.back();
-    heap.pop_back();
+template <typename Policy>
+void BasicPriorityQueue<Policy>::insertBatch(Process* const* processes, size_t count) {
+    OpScope scope(op_stats.insert_batch, heap.counts());
+    reserveSequences(processes, count);
+    batch_nodes.clear();
+    for (size_t i = 0; i < count; i++) {
+        Process* process = processes[i];
+        if (!process) continue;
 
-    if (!isEmpty()) {
-        heapifyDown(0);
+        long long waited_before = process->getWaitingTime();
+        process->template updateEffectivePriority<Policy>(current_time, aging_factor);
+        uint32_t slot = acquireSlot(process, waited_before);
+        if (backend == QueueBackend::Heap) {
+            batch_nodes.push_back({heapKey(slot), slot});
+        } else {
+            pushEntry(slot);
+        }
+        if (!max_key_stale) {
+            max_key = std::max(max_key, agingKey(process));
+        }
+    }
+    // Large batches are heapified bottom-up instead of sifted in one by one
+    heap.pushBatch(batch_nodes.data(), batch_nodes.size());
+    if (tracksLowest()) {
+        shed_heap.pushBatch(batch_nodes.data(), batch_nodes.size());
+    }
+}
+
+template <typename Policy>
+size_t BasicPriorityQueue<Policy>::extractTopK(size_t k, std::vector<Process*>& out) {
+    OpScope scope(op_stats.extract_top_k, heap.counts());
+    size_t taken = std::min(k, static_cast<size_t>(size()));
+    if (backend == QueueBackend::Heap) {
+        batch_nodes.clear();
+        heap.popBatch(taken, batch_nodes);
+        for (const auto& node : batch_nodes) {
+            if (tracksLowest()) {
+                shed_heap.erase(node.payload);
+            }
+            out.push_back(releaseSlot(node.payload));
+        }
+    } else {
+        for (size_t i = 0; i < taken; i++) {
+            out.push_back(releaseSlot(popEntry()));
+        }
+    }
+    return taken;
+}
+
+template <typename Policy>
+Process* BasicPriorityQueue<Policy>::offer(Process* process) {
+    if (!process || !isFull()) {
+        insert(process);
+        return nullptr;
+    }
+    if (overflow != OverflowPolicy::EvictLowest) {
+        return process;
+    }
+
+    // The arrival competes too: queued first, it is the one shed when
+    // nothing ranks below it
+    insert(process);
+    uint32_t slot = shed_heap.top().payload;
+    eraseEntry(slot);
+    return releaseSlot(slot);
+}
+
+template <typename Policy>
+void BasicPriorityQueue<Policy>::indexIds() const {
+    if (ids_indexed) {
+        return;
+    }
+    slot_of.reserve(size());
+    forEachEntry([this](uint32_t slot) { slot_of[slots[slot]->getId()] = slot; });
+    ids_indexed = true;
+}
+
+template <typename Policy>
+bool BasicPriorityQueue<Policy>::contains(int id) const {
+    indexIds();
+    return slot_of.count(id) != 0;
+}
+
+template <typename Policy>
+Process* BasicPriorityQueue<Policy>::erase(int id) {
+    indexIds();
+    auto it = slot_of.find(id);
+    if (it == slot_of.end()) {
+        return nullptr;
+    }
+
+    uint32_t slot = it->second;
+    eraseEntry(slot);
+    return releaseSlot(slot);
+}
+
+template <typename Policy>
+bool BasicPriorityQueue<Policy>::updatePriority(int id, int new_base_priority) {
+    indexIds();
+    auto it = slot_of.find(id);
+    if (it == slot_of.end()) {
+        return false;
     }
 
-    return minProcess;
+    uint32_t slot = it->second;
+    Process* process = slots[slot];
+    checkKey(new_base_priority, process);
+    process->setBasePriority(new_base_priority);
+    max_key_stale = true;
+    process->template updateEffectivePriority<Policy>(current_time, aging_factor);
+    if (bulkAging()) {
+        slot_base[slot] = new_base_priority;
+        slot_effective[slot] = process->getEffectivePriority();
+    }
+    updateEntry(slot);
+    return true;
 }
 
-Process* PriorityQueue::peek() const {
+template <typename Policy>
+Process* BasicPriorityQueue<Policy>::peek() const {
     if (isEmpty()) {
         return nullptr;
     }
-    return heap[0];
+    Process* top = slots[topEntry()];
+    observe(top);
+    return top;
+}
+
+template <typename Policy>
+void BasicPriorityQueue<Policy>::getEffectivePriorityRange(long long time, double& lowest, double& highest) const {
+    if (isEmpty()) {
+        lowest = highest = 0.0;
+        return;
+    }
+    if constexpr (Policy::ORDER_INVARIANT) {
+        if (max_key_stale) {
+            max_key = LOWEST_KEY;
+            forEachEntry([this](uint32_t slot) { max_key = std::max(max_key, agingKey(slots[slot])); });
+            max_key_stale = false;
+        }
+        // While queued the effective priority follows from the aging key; the
+        // head has the smallest key in either mode
+        lowest = Policy::effectiveFromKey(agingKey(slots[topEntry()]), time, aging_factor);
+        highest = Policy::effectiveFromKey(max_key, time, aging_factor);
+    } else {
+        // The order changes with time, so neither end is known without a scan
+        lowest = HUGE_VAL;
+        highest = 0.0;
+        forEachEntry([this, time, &lowest, &highest](uint32_t slot) {
+            const Process* process = slots[slot];
+            long long origin = process->getReadyOrigin();
+            double effective = Policy::effective(process->getBasePriority(),
+                                                 std::max(0LL, time - origin), aging_factor);
+            lowest = std::min(lowest, effective);
+            highest = std::max(highest, effective);
+        });
+    }
 }
 
-void PriorityQueue::updateAllPriorities(int current_time) {
+template <typename Policy>
+void BasicPriorityQueue<Policy>::updateAllPriorities(long long current_time) {
     this->current_time = current_time;
 
-    for (Process* process : heap) {
-        double old_priority = process->getEffectivePriority();
-        process->updateEffectivePriority(current_time, aging_factor);
-        double new_priority = process->getEffectivePriority();
+    forEachEntry([this, current_time](uint32_t slot) {
+        slots[slot]->template updateEffectivePriority<Policy>(current_time, aging_factor);
+        if (bulkAging()) {
+            slot_effective[slot] = slots[slot]->getEffectivePriority();
+        }
+    });
+}
 
-        if (std::abs(new_priority - old_priority) > 0.01) {
-            aging_events++;
+template <typename Policy>
+void BasicPriorityQueue<Policy>::applyAging(long long current_time) {
+    if constexpr (INSTRUMENTED) {
+        op_stats.aging_calls++;
+    }
+    TimeScope timer(op_stats.aging_ns);
+    if (Policy::ORDER_INVARIANT && mode == AgingMode::Lazy) {
+        // Keys are time-invariant: the heap stays valid as time advances
+        this->current_time = current_time;
+        return;
+    }
+    if constexpr (BULK_AGING) {
+        if (backend == QueueBackend::Heap) {
+            // One pass over contiguous arrays; processes catch up when
+            // observed. If no key moved (between steps, everyone at the floor
+            // or the cap) the heap is still valid.
+            this->current_time = current_time;
+            size_t changed = recomputeEffective(slot_origin.data(), slot_base.data(),
+                                                slot_effective.data(), slot_origin.size(),
+                                                current_time, aging_factor,
+                                                AgingShape{Policy::STEP, Policy::CAP});
+            if (changed > 0) {
+                rebuildHeap();
+            }
+            return;
         }
     }
+    updateAllPriorities(current_time);
+    if (backend == QueueBackend::Heap) {
+        rebuildHeap();
+    }
+}
+
+template <typename Policy>
+void BasicPriorityQueue<Policy>::rebuildHeap() {
+    OpScope scope(op_stats.rebuild, heap.counts());
+    if (backend == QueueBackend::Heap) {
+        heap.rekey([this](typename EntryHeap::Node& node) {
+            node.key = heapKey(node.payload);
+        });
+    } else {
+        buckets.rekey([this](typename EntryBuckets::Node& node) {
+            node.key = heapKey(node.payload);
+            return slots[node.payload]->getBasePriority();
+        });
+    }
+    if (tracksLowest()) {
+        shed_heap.rekey([this](typename ShedHeap::Node& node) {
+            node.key = heapKey(node.payload);
+        });
+    }
+}
+
+template <typename Policy>
+void BasicPriorityQueue<Policy>::syncBulkArrays() {
+    slot_origin.clear();
+    slot_base.clear();
+    slot_effective.clear();
+    if (!bulkAging()) {
+        return;
+    }
+    slot_origin.assign(slots.size(), HUGE_VAL);
+    slot_base.assign(slots.size(), 0.0);
+    slot_effective.assign(slots.size(), 0.0);
+    forEachEntry([this](uint32_t slot) {
+        const Process* process = slots[slot];
+        slot_origin[slot] = static_cast<double>(process->getReadyOrigin());
+        slot_base[slot] = process->getBasePriority();
+        slot_effective[slot] = process->getEffectivePriority();
+    });
+}
+
+template <typename Policy>
+void BasicPriorityQueue<Policy>::renumberSequences() {
+    // The sequence ran out of bits: number the queued entries 0..n-1 again
+    // in their insertion order. The key order is unchanged.
+    std::vector<uint32_t> queued;
+    queued.reserve(size());
+    forEachEntry([&queued](uint32_t slot) { queued.push_back(slot); });
+    std::sort(queued.begin(), queued.end(), [this](uint32_t a, uint32_t b) {
+        return slot_sequence[a] < slot_sequence[b];
+    });
+    for (size_t i = 0; i < queued.size(); i++) {
+        slot_sequence[queued[i]] = i;
+    }
+    next_sequence = queued.size();
+    rebuildHeap();
 }
 
-void PriorityQueue::applyAging(int current_time) {
+template <typename Policy>
+void BasicPriorityQueue<Policy>::setAgingMode(AgingMode m) {
+    // Lazy mode leaves queued processes behind; bring them up to date
     updateAllPriorities(current_time);
+    mode = supportedMode(m);
+    syncBulkArrays();
+    rebuildHeap();
+}
+
+template <typename Policy>
+void BasicPriorityQueue<Policy>::setBackend(QueueBackend b) {
+    if (b == backend || !Policy::ORDER_INVARIANT) {
+        return;
+    }
+    // Move queued entries across; keys depend on the backend in Eager mode
+    std::vector<uint32_t> queued;
+    queued.reserve(size());
+    forEachEntry([&queued](uint32_t slot) { queued.push_back(slot); });
+    heap.clear();
+    buckets.clear();
+    shed_heap.clear();
+    backend = b;
+    for (uint32_t slot : queued) {
+        pushEntry(slot);
+    }
     rebuildHeap();
 }
 
-void PriorityQueue::rebuildHeap() {
-    for (int i = heap.size() / 2 - 1; i >= 0; i--) {
-        heapifyDown(i);
+template <typename Policy>
+void BasicPriorityQueue<Policy>::setCapacity(size_t max_entries, OverflowPolicy policy) {
+    capacity = max_entries;
+    overflow = policy;
+    shed_heap.clear();
+    if (tracksLowest()) {
+        forEachEntry([this](uint32_t slot) { shed_heap.push(heapKey(slot), slot); });
     }
 }
 
-std::vector<Process*> PriorityQueue::getQueueSnapshot() const {
-    return heap;
+template <typename Policy>
+std::vector<Process*> BasicPriorityQueue<Policy>::getQueueSnapshot() const {
+    std::vector<Process*> snapshot;
+    snapshot.reserve(size());
+    forEachEntry([this, &snapshot](uint32_t slot) {
+        Process* process = slots[slot];
+        observe(process);
+        snapshot.push_back(process);
+    });
+    return snapshot;
 }
 
-void PriorityQueue::display() const {
+template <typename Policy>
+void BasicPriorityQueue<Policy>::display() const {
     if (isEmpty()) {
         std::cout << "  [Queue is empty]" << std::endl;
         return;
     }
 
     std::cout << "  Queue (" << size() << " processes): ";
-    for (size_t i = 0; i < heap.size(); i++) {
-        std::cout << heap[i]->toString();
-        if (i < heap.size() - 1) {
+    int shown = 0;
+    forEachEntry([this, &shown](uint32_t slot) {
+        Process* process = slots[slot];
+        observe(process);
+        if (shown++ > 0) {
             std::cout << ", ";
         }
-    }
+        std::cout << process->toString();
+    });
     std::cout << std::endl;
 }
 
-void PriorityQueue::displayDetailed() const {
+template <typename Policy>
+void BasicPriorityQueue<Policy>::displayDetailed() const {
     if (isEmpty()) {
         std::cout << "  [Queue is empty]" << std::endl;
         return;
     }
 
     std::cout << "  Queue (" << size() << " processes):" << std::endl;
-    for (size_t i = 0; i < heap.size(); i++) {
-        std::cout << "    [" << i << "] " << heap[i]->toDetailedString() << std::endl;
-    }
+    int index = 0;
+    forEachEntry([this, &index](uint32_t slot) {
+        Process* process = slots[slot];
+        observe(process);
+        std::cout << "    [" << index++ << "] " << process->toDetailedString() << std::endl;
+    });
 }
+
+template class BasicPriorityQueue<LinearAging>;
+template class BasicPriorityQueue<ExponentialAging>;
+template class BasicPriorityQueue<StepAging<>>;
+template class BasicPriorityQueue<CappedAging<>>;
+template class BasicPriorityQueue<FixedPointAging>;
@@ -3,36 +3,22 @@
 #include <iomanip>
 #include <algorithm>
 
-Process::Process(int id, int priority, int arrival, int burst)
-    : id(id), base_priority(priority), arrival_time(arrival),
-      burst_time(burst), remaining_time(burst), waiting_time(0),
-      start_time(-1), completion_time(-1), effective_priority(priority) {
+Process::Process(int id, int priority, long long arrival, int burst, int io_interval, int io_time)
+    : arrival_time(arrival), base_priority(priority), burst_time(burst),
+      remaining_time(burst), id(id), waiting_time(0), effective_priority(priority),
+      io_interval(io_interval), io_time(io_time), blocked_time(0),
+      start_time(-1), completion_time(-1) {
 }
 
-void Process::updateEffectivePriority(int current_time, double aging_factor) {
-    if (completion_time != -1) {
-        return;
-    }
-
-    int time_waited = current_time - arrival_time;
-    if (start_time != -1) {
-        time_waited -= (current_time - start_time);
-    }
-
-    waiting_time = std::max(0, time_waited);
-
-    effective_priority = base_priority - (waiting_time * aging_factor);
-    effective_priority = std::max(0.0, effective_priority);
-}
-
-int Process::getTurnaroundTime() const {
+long long Process::getTurnaroundTime() const {
     if (completion_time == -1) {
         return -1;
     }
     return completion_time - arrival_time;
 }
 
-int Process::getResponseTime() const {
+long long Process::getResponseTime() const {
+    // start_time is the first dispatch; later slices after preemption do not move it
     if (start_time == -1) {
         return -1;
     }
@@ -57,6 +43,9 @@ std::string Process::toDetailedString() const {
         << ", Remaining=" << remaining_time
         << ", Waiting=" << waiting_time;
 
+    if (io_interval > 0) {
+        oss << ", I/O=" << io_time << " every " << io_interval;
+    }
     if (start_time != -1) {
         oss << ", Start=" << start_time;
     }
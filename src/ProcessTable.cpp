@@ -0,0 +1,54 @@
+#include "ProcessTable.h"
+#include <algorithm>
+#include <utility>
+
+ProcessTable::ProcessTable() : count(0) {
+}
+
+uint32_t ProcessTable::add(const Process& process) {
+    if ((count & CHUNK_MASK) == 0 && (count >> CHUNK_BITS) == chunks.size()) {
+        chunks.push_back(std::make_unique<std::vector<Process>>());
+        chunks.back()->reserve(CHUNK_SIZE);
+    }
+    // Never exceeds the reserved capacity, so existing records do not move
+    chunks[count >> CHUNK_BITS]->push_back(process);
+    return count++;
+}
+
+uint32_t ProcessTable::add(int id, int priority, long long arrival, int burst) {
+    return add(Process(id, priority, arrival, burst));
+}
+
+void ProcessTable::sortByArrival() {
+    bool sorted = true;
+    for (uint32_t i = 1; i < count && sorted; i++) {
+        sorted = (*this)[i - 1].getArrivalTime() <= (*this)[i].getArrivalTime();
+    }
+    if (sorted) {
+        return;
+    }
+
+    // Sort (arrival, index) pairs rather than indices so comparisons stay in
+    // one contiguous array; the index makes the order stable
+    std::vector<std::pair<long long, uint32_t>> order;
+    order.reserve(count);
+    for (uint32_t i = 0; i < count; i++) {
+        order.emplace_back((*this)[i].getArrivalTime(), i);
+    }
+    std::sort(order.begin(), order.end());
+
+    ProcessTable sorted_table;
+    for (const auto& entry : order) {
+        sorted_table.add((*this)[entry.second]);
+    }
+    chunks.swap(sorted_table.chunks);
+}
+
+void ProcessTable::clear() {
+    chunks.clear();
+    count = 0;
+}
+
+size_t ProcessTable::memoryUsage() const {
+    return chunks.size() * (CHUNK_SIZE * sizeof(Process) + sizeof(std::vector<Process>));
+}
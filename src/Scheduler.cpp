@@ -1,7 +1,7 @@
 #include "Scheduler.h"
+#include "FrameRenderer.h"
 #include <iostream>
 #include <algorithm>
-#include <random>
 #include <chrono>
 #include <thread>
 
@@ -9,176 +9,580 @@
 #include <windows.h>
 #endif
 
-Scheduler::Scheduler(double aging_factor, bool verbose)
-    : queue(aging_factor), current_time(0), verbose(verbose),
-      visualization_delay(500) {
+template <typename Policy>
+BasicScheduler<Policy>::BasicScheduler(double aging_factor, bool verbose)
+    : queue(aging_factor), current_time(0), next_arrival(0), verbose(verbose),
+      visualization_delay(500), renderer(nullptr), preemptive(false), time_quantum(0),
+      source(nullptr), streamed(0) {
 }
 
-Scheduler::~Scheduler() {
-    cleanup();
+template <typename Policy>
+BasicScheduler<Policy>::~BasicScheduler() {
 }
 
-void Scheduler::cleanup() {
-    for (auto* process : all_processes) {
-        delete process;
-    }
-    all_processes.clear();
-    completed_processes.clear();
+template <typename Policy>
+void BasicScheduler<Policy>::addProcess(const Process& process) {
+    processes.add(process);
+}
+
+template <typename Policy>
+void BasicScheduler<Policy>::addProcess(int id, int priority, long long arrival, int burst) {
+    processes.add(id, priority, arrival, burst);
+}
+
+template <typename Policy>
+void BasicScheduler<Policy>::generateRandomProcesses(int count, int max_priority,
+                                        int max_arrival, int max_burst, uint64_t seed) {
+    // Uniform arrivals over [0, max_arrival], uniform priorities and bursts
+    WorkloadSpec spec;
+    spec.seed = seed;
+    spec.count = count;
+    spec.arrivals = ArrivalPattern::Uniform;
+    spec.horizon = max_arrival;
+    spec.max_priority = max_priority;
+    spec.max_burst = max_burst;
+    generateWorkload(spec);
+}
+
+template <typename Policy>
+void BasicScheduler<Policy>::generateWorkload(const WorkloadSpec& spec) {
+    // Generated in arrival order, so the table needs no sort
+    WorkloadGenerator(spec).generate(processes);
+}
+
+template <typename Policy>
+bool BasicScheduler<Policy>::arrivalsPending() {
+    return source ? source->peek() != nullptr : next_arrival < processes.size();
 }
 
-void Scheduler::addProcess(Process* process) {
-    if (process) {
-        all_processes.push_back(process);
+template <typename Policy>
+long long BasicScheduler<Policy>::nextArrivalTime() {
+    return source ? source->peek()->arrival : processes[next_arrival].getArrivalTime();
+}
+
+template <typename Policy>
+Process* BasicScheduler<Policy>::admitFromSource(const TraceRecord& record) {
+    Process process(record.id, record.priority, record.arrival, record.burst,
+                    record.io_interval, record.io_time);
+    streamed++;
+    if (!free_records.empty()) {
+        Process* recycled = free_records.back();
+        free_records.pop_back();
+        *recycled = process;
+        return recycled;
     }
+    return &processes[processes.add(process)];
 }
 
-void Scheduler::addProcess(int id, int priority, int arrival, int burst) {
-    addProcess(new Process(id, priority, arrival, burst));
+template <typename Policy>
+Process* BasicScheduler<Policy>::takeArrival() {
+    Process* process;
+    if (source) {
+        // Records arriving late (trace out of order across windows) are
+        // admitted now with their original arrival time
+        process = admitFromSource(*source->peek());
+        source->advance();
+    } else {
+        process = &processes[next_arrival++];
+    }
+    if (verbose) {
+        std::cout << "  Process " << process->getId()
+                  << " arrived (Priority: " << process->getBasePriority()
+                  << ", Burst: " << process->getBurstTime() << ")" << std::endl;
+    }
+    return process;
 }
 
-void Scheduler::generateRandomProcesses(int count, int max_priority,
-                                       int max_arrival, int max_burst) {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> priority_dist(1, max_priority);
-    std::uniform_int_distribution<> arrival_dist(0, max_arrival);
-    std::uniform_int_distribution<> burst_dist(1, max_burst);
+template <typename Policy>
+Process* BasicScheduler<Policy>::takeWakeup() {
+    Process* process = blocked.popDue();
+    if (verbose) {
+        std::cout << "  Process " << process->getId()
+                  << " finished I/O (Remaining: " << process->getRemainingTime() << ")" << std::endl;
+    }
+    return process;
+}
 
-    for (int i = 0; i < count; i++) {
-        int priority = priority_dist(gen);
-        int arrival = arrival_dist(gen);
-        int burst = burst_dist(gen);
-        addProcess(new Process(i + 1, priority, arrival, burst));
+template <typename Policy>
+void BasicScheduler<Policy>::blockForIo(Process* process) {
+    // The I/O time counts as blocked from now on, so the aging key the
+    // process rejoins the queue with excludes it
+    blocked.schedule(current_time + process->getIoTime(), process);
+    process->beginIo();
+    if (verbose) {
+        std::cout << "  Process " << process->getId() << " blocked on I/O until "
+                  << current_time + process->getIoTime() << std::endl;
     }
+}
 
-    std::sort(all_processes.begin(), all_processes.end(),
-              [](const Process* a, const Process* b) {
-                  return a->getArrivalTime() < b->getArrivalTime();
-              });
+template <typename Policy>
+long long BasicScheduler<Policy>::nextEventTime() {
+    long long wakeup = blocked.nextExpiry();
+    return arrivalsPending() ? std::min(nextArrivalTime(), wakeup) : wakeup;
 }
 
-void Scheduler::addArrivedProcesses() {
-    for (auto* process : all_processes) {
-        if (process->getArrivalTime() == current_time && !process->hasStarted()) {
-            queue.insert(process);
-            if (verbose) {
-                std::cout << "  Process " << process->getId()
-                          << " arrived (Priority: " << process->getBasePriority()
-                          << ", Burst: " << process->getBurstTime() << ")" << std::endl;
-            }
+template <typename Policy>
+bool BasicScheduler<Policy>::addArrivedProcesses() {
+    blocked.advance(current_time);
+    if (queue.getCapacity() > 0) {
+        // Woken processes were admitted before and go back past the bound,
+        // like a preempted one
+        bool woken = blocked.hasDue();
+        while (blocked.hasDue()) {
+            queue.insert(takeWakeup());
+        }
+        return offerArrivals() || woken;
+    }
+    // Everything arriving or waking up by now goes into the queue as one
+    // batch, in time order (a wakeup first at equal times), so both engines
+    // insert in the same order
+    arrival_batch.clear();
+    while (true) {
+        bool arrival = arrivalsPending() && nextArrivalTime() <= current_time;
+        if (blocked.hasDue() && (!arrival || blocked.dueTime() <= nextArrivalTime())) {
+            arrival_batch.push_back(takeWakeup());
+        } else if (arrival) {
+            arrival_batch.push_back(takeArrival());
+        } else {
+            break;
         }
     }
+    queue.insertBatch(arrival_batch);
+    return !arrival_batch.empty();
 }
 
-void Scheduler::run() {
-    if (all_processes.empty()) {
-        std::cout << "No processes to schedule!" << std::endl;
-        return;
+template <typename Policy>
+bool BasicScheduler<Policy>::offerArrivals() {
+    // Bounded queue: arrivals one at a time through admission control.
+    // Eviction compares effective priorities, so the queue is aged to now
+    // first. Under backpressure the rest stay with the producer (table
+    // cursor or source) until dispatch frees a place.
+    if (!arrivalsPending() || nextArrivalTime() > current_time) {
+        return false;
     }
+    queue.applyAging(current_time);
 
-    std::sort(all_processes.begin(), all_processes.end(),
-              [](const Process* a, const Process* b) {
-                  return a->getArrivalTime() < b->getArrivalTime();
-              });
+    bool admitted = false;
+    while (arrivalsPending() && nextArrivalTime() <= current_time && !producerBlocked()) {
+        Process* process = takeArrival();
+        Process* dropped = queue.offer(process);
+        admitted = admitted || dropped != process;
+        if (!dropped) {
+            continue;
+        }
+        if (dropped == process) {
+            stats.recordRejection();
+        } else {
+            stats.recordShed();
+        }
+        if (verbose) {
+            std::cout << "  Process " << dropped->getId()
+                      << (dropped == process ? " rejected" : " shed") << " (queue full)" << std::endl;
+        }
+        if (source) {
+            free_records.push_back(dropped);
+        }
+    }
+    return admitted;
+}
 
-    stats.setTotalProcesses(all_processes.size());
+template <typename Policy>
+bool BasicScheduler<Policy>::producerBlocked() const {
+    return queue.getOverflowPolicy() == OverflowPolicy::Backpressure && queue.isFull();
+}
+
+template <typename Policy>
+bool BasicScheduler<Policy>::beginRun() {
+    if (source) {
+        processes.clear();
+        free_records.clear();
+        streamed = 0;
+    }
     current_time = 0;
-    int next_arrival_idx = 0;
+    next_arrival = 0;
+    blocked.clear();
+    telemetry.begin(queue);
+    execution_log.clear();
+
+    if (!arrivalsPending()) {
+        if (verbose) {
+            std::cout << "No processes to schedule!" << std::endl;
+        }
+        return false;
+    }
+
+    // Stable so processes with equal arrival times keep their insertion order
+    processes.sortByArrival();
+
+    stats.setTotalProcesses(processes.size());
 
     if (verbose) {
         Visualizer::printHeader("SCHEDULING SIMULATION START");
-        std::cout << "Aging Factor: " << queue.getAgingEvents() << std::endl;
-        std::cout << "Total Processes: " << all_processes.size() << std::endl;
+        std::cout << "Aging Factor: " << queue.getAgingFactor() << std::endl;
+        if (!source) {
+            std::cout << "Total Processes: " << processes.size() << std::endl;
+        }
         Visualizer::printSeparator('-', 60);
     }
+    return true;
+}
 
-    while (next_arrival_idx < all_processes.size() || !queue.isEmpty()) {
-        addArrivedProcesses();
+template <typename Policy>
+void BasicScheduler<Policy>::completeProcess(Process* process) {
+    process->setCompletionTime(current_time);
+    process->setWaitingTime(
+        process->getCompletionTime() -
+        process->getArrivalTime() -
+        process->getBurstTime() -
+        process->getBlockedTime()
+    );
 
-        if (!queue.isEmpty()) {
-            queue.applyAging(current_time);
+    stats.recordProcess(process);
 
-            Process* current_process = queue.extractMin();
+    if (verbose) {
+        std::cout << "  Process " << process->getId()
+                  << " completed at time " << current_time
+                  << " (Waiting: " << process->getWaitingTime()
+                  << ", Turnaround: " << process->getTurnaroundTime()
+                  << ")" << std::endl;
+    }
 
-            if (current_process->getStartTime() == -1) {
-                current_process->setStartTime(current_time);
-            }
+    if (source) {
+        free_records.push_back(process);
+    }
+}
 
-            if (verbose) {
-                Visualizer::displayTimeStep(current_time,
-                    "Executing " + current_process->toString());
-                queue.display();
-            }
+template <typename Policy>
+void BasicScheduler<Policy>::finishRun() {
+    if (source) {
+        stats.setTotalProcesses(streamed);
+    }
+    stats.setTotalExecutionTime(current_time);
+    stats.recordAgingEvents(queue.getAgingEvents());
+    if (renderer) {
+        publishFrame(nullptr, current_time, true);
+    }
 
-            int execution_time = current_process->getBurstTime();
-            for (int t = 0; t < execution_time; t++) {
-                current_process->decrementRemainingTime();
-                current_time++;
-                addArrivedProcesses();
-                queue.applyAging(current_time);
+    if (verbose) {
+        Visualizer::printSeparator('=', 60);
+        std::cout << "SIMULATION COMPLETED at time " << current_time << std::endl;
+        Visualizer::printSeparator('=', 60);
+    }
+}
+
+template <typename Policy>
+void BasicScheduler<Policy>::publishFrame(const Process* running, long long until, bool final_frame) {
+    // Snapshots are only built once the renderer took the previous one, so
+    // the cost follows the frame rate, not the event rate
+    if (!final_frame && !renderer->ready()) {
+        return;
+    }
+    FrameSnapshot& frame = renderer->snapshot();
+    frame.time = current_time;
+    frame.running_id = running ? running->getId() : -1;
+    frame.running_priority = running ? running->getBasePriority() : 0;
+    frame.running_remaining = running ? running->getRemainingTime() : 0;
+    frame.completed = static_cast<int>(stats.getCompletedProcesses());
+    frame.total = source ? 0 : static_cast<int>(processes.size());
+    frame.queue_length = queue.size();
 
-                if (verbose && visualization_delay > 0) {
-                    std::this_thread::sleep_for(std::chrono::milliseconds(visualization_delay));
+    std::vector<Process*> queued = queue.getQueueSnapshot();
+    size_t rows = std::min(queued.size(), FrameRenderer::QUEUE_ROWS);
+    std::partial_sort(queued.begin(), queued.begin() + rows, queued.end(),
+                      [](const Process* a, const Process* b) {
+                          if (a->getEffectivePriority() != b->getEffectivePriority()) {
+                              return a->getEffectivePriority() < b->getEffectivePriority();
+                          }
+                          if (a->getArrivalTime() != b->getArrivalTime()) {
+                              return a->getArrivalTime() < b->getArrivalTime();
+                          }
+                          return a->getId() < b->getId();
+                      });
+    frame.queue.clear();
+    for (size_t i = 0; i < rows; i++) {
+        const Process* p = queued[i];
+        frame.queue.push_back({p->getId(), p->getBasePriority(), p->getEffectivePriority(),
+                               p->getRemainingTime()});
+    }
+
+    if (final_frame) {
+        frame.event = "Simulation completed at time " + std::to_string(current_time);
+    } else if (running) {
+        frame.event = "Executing P" + std::to_string(running->getId()) +
+                      " until " + std::to_string(until);
+    } else {
+        frame.event = "CPU idle until " + std::to_string(until);
+    }
+    renderer->publish();
+}
+
+template <typename Policy>
+void BasicScheduler<Policy>::pace(long long time_units) {
+    // Demo pacing only: output is handed off (flushed or published) first,
+    // so the wait is never on the terminal
+    if (visualization_delay <= 0 || (!verbose && !renderer)) {
+        return;
+    }
+    if (verbose) {
+        std::cout.flush();
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(visualization_delay) * time_units);
+}
+
+template <typename Policy>
+Process* BasicScheduler<Policy>::dispatch(Process* preempted) {
+    queue.applyAging(current_time);
+    Process* process = queue.extractMin();
+    if (queue.getCapacity() > 0) {
+        // The freed place goes to an arrival held back by backpressure now,
+        // in both engines alike
+        offerArrivals();
+    }
+
+    if (process->getStartTime() == -1) {
+        process->setStartTime(current_time);
+    }
+    if (preempted && process != preempted) {
+        stats.recordPreemption();
+    }
+
+    if (verbose) {
+        Visualizer::displayTimeStep(current_time,
+            "Executing " + process->toString());
+        queue.display();
+    }
+    return process;
+}
+
+template <typename Policy>
+bool BasicScheduler<Policy>::preemptIfNeeded(Process* running, int slice_used, bool arrivals) {
+    if (!preemptive) {
+        return false;
+    }
+
+    bool quantum_expired = time_quantum > 0 && slice_used >= time_quantum;
+    bool outranked = false;
+    if (!quantum_expired && arrivals) {
+        // Only the queue head can outrank the running process: O(1)
+        Process* head = queue.peek();
+        running->template updateEffectivePriority<Policy>(current_time, queue.getAgingFactor());
+        outranked = head->getEffectivePriority() < running->getEffectivePriority();
+    }
+    if (!quantum_expired && !outranked) {
+        return false;
+    }
+
+    // Requeued with its remaining time; waiting resumes from where it stopped
+    queue.insert(running);
+    if (verbose) {
+        std::cout << "  Process " << running->getId()
+                  << (quantum_expired ? " used its quantum" : " preempted")
+                  << " (Remaining: " << running->getRemainingTime() << ")" << std::endl;
+    }
+    return true;
+}
+
+template <typename Policy>
+void BasicScheduler<Policy>::run() {
+    if (!beginRun()) {
+        return;
+    }
+
+    // Discrete-event loop: time jumps straight to the next event instead of
+    // stepping one unit at a time. Events are arrivals, completions, I/O
+    // requests and wakeups and, in preemptive mode, quantum expiries. The
+    // queue order is total and only observed at those events, so the
+    // schedule is identical to runTickBased().
+    Process* running = nullptr;
+    int slice_used = 0;
+
+    while (arrivalsPending() || !queue.isEmpty() || running || !blocked.empty()) {
+        bool arrivals = addArrivedProcesses();
+        queue.applyAging(current_time);
+
+        Process* preempted = nullptr;
+        if (running && preemptIfNeeded(running, slice_used, arrivals)) {
+            preempted = running;
+            running = nullptr;
+        }
+
+        if (!running) {
+            if (queue.isEmpty()) {
+                long long next_time = nextEventTime();
+                if (verbose) {
+                    Visualizer::displayTimeStep(current_time,
+                        "CPU Idle until " + std::to_string(next_time));
                 }
+                telemetry.advance(current_time, next_time, false, queue);
+                if (renderer) {
+                    publishFrame(nullptr, next_time);
+                }
+                current_time = next_time;
+                continue;
             }
+            running = dispatch(preempted);
+            slice_used = 0;
+        }
 
-            current_process->setCompletionTime(current_time);
-            current_process->setWaitingTime(
-                current_process->getCompletionTime() -
-                current_process->getArrivalTime() -
-                current_process->getBurstTime()
-            );
-
-            completed_processes.push_back(current_process);
-            stats.recordProcess(current_process);
-
-            if (verbose) {
-                std::cout << "  Process " << current_process->getId()
-                          << " completed at time " << current_time
-                          << " (Waiting: " << current_process->getWaitingTime()
-                          << ", Turnaround: " << current_process->getTurnaroundTime()
-                          << ")" << std::endl;
-            }
-        } else {
-            if (verbose) {
-                Visualizer::displayTimeStep(current_time, "CPU Idle");
+        long long next_event = current_time + running->getCpuUntilIo();
+        if (preemptive && time_quantum > 0) {
+            next_event = std::min(next_event, current_time + time_quantum - slice_used);
+        }
+        // Arrivals and wakeups end a segment when they may preempt, with
+        // telemetry on so samples see the queue grow, or into a bounded
+        // queue so admission sees the queue as it is on arrival (a blocked
+        // producer waits for the next dispatch instead); without preemption
+        // the split leaves the schedule unchanged
+        bool split = preemptive || telemetry.isEnabled() || queue.getCapacity() > 0;
+        if (split) {
+            next_event = std::min(next_event, blocked.nextExpiry());
+            if (arrivalsPending() && !producerBlocked()) {
+                next_event = std::min(next_event, nextArrivalTime());
             }
-            current_time++;
+        }
+        telemetry.advance(current_time, next_event, true, queue);
+        execution_log.record(running->getId(), 0, current_time, next_event);
+        if (renderer) {
+            publishFrame(running, next_event);
         }
 
-        while (next_arrival_idx < all_processes.size() &&
-               all_processes[next_arrival_idx]->hasStarted()) {
-            next_arrival_idx++;
+        int execution_time = static_cast<int>(next_event - current_time);
+        running->execute(execution_time);
+        slice_used += execution_time;
+        current_time = next_event;
+
+        pace(execution_time);
+
+        if (running->isCompleted()) {
+            queue.applyAging(current_time);
+            completeProcess(running);
+            running = nullptr;
+        } else if (running->needsIo()) {
+            blockForIo(running);
+            running = nullptr;
         }
     }
 
-    stats.setTotalExecutionTime(current_time);
-    int total_aging_events = queue.getAgingEvents();
-    for (int i = 0; i < total_aging_events; i++) {
-        stats.recordAgingEvent();
+    finishRun();
+}
+
+template <typename Policy>
+void BasicScheduler<Policy>::runTickBased() {
+    if (!beginRun()) {
+        return;
     }
 
-    if (verbose) {
-        Visualizer::printSeparator('=', 60);
-        std::cout << "SIMULATION COMPLETED at time " << current_time << std::endl;
-        Visualizer::printSeparator('=', 60);
+    Process* running = nullptr;
+    int slice_used = 0;
+
+    while (arrivalsPending() || !queue.isEmpty() || running || !blocked.empty()) {
+        bool arrivals = addArrivedProcesses();
+        queue.applyAging(current_time);
+
+        Process* preempted = nullptr;
+        if (running && preemptIfNeeded(running, slice_used, arrivals)) {
+            preempted = running;
+            running = nullptr;
+        }
+
+        if (!running) {
+            if (queue.isEmpty()) {
+                if (verbose) {
+                    Visualizer::displayTimeStep(current_time, "CPU Idle");
+                }
+                telemetry.advance(current_time, current_time + 1, false, queue);
+                if (renderer) {
+                    publishFrame(nullptr, current_time + 1);
+                }
+                current_time++;
+                continue;
+            }
+            running = dispatch(preempted);
+            slice_used = 0;
+        }
+
+        telemetry.advance(current_time, current_time + 1, true, queue);
+        execution_log.record(running->getId(), 0, current_time, current_time + 1);
+        if (renderer) {
+            publishFrame(running, current_time + running->getCpuUntilIo());
+        }
+        running->decrementRemainingTime();
+        slice_used++;
+        current_time++;
+
+        pace(1);
+
+        if (running->isCompleted()) {
+            queue.applyAging(current_time);
+            completeProcess(running);
+            running = nullptr;
+        } else if (running->needsIo()) {
+            blockForIo(running);
+            running = nullptr;
+        }
     }
+
+    finishRun();
 }
 
-void Scheduler::runWithVisualization(int delay_ms) {
+template <typename Policy>
+void BasicScheduler<Policy>::runWithVisualization(int delay_ms) {
+    // Tick by tick, so the view counts down every time unit; the event log
+    // would scroll the view away, so verbose output is off meanwhile
+    FrameRenderer live;
+    bool was_verbose = verbose;
     setVisualizationDelay(delay_ms);
-    setVerbose(true);
-    run();
+    setVerbose(false);
+    setRenderer(&live);
+    live.start();
+    runTickBased();
+    live.stop();
+    setRenderer(nullptr);
+    setVerbose(was_verbose);
+}
+
+template <typename Policy>
+std::vector<const Process*> BasicScheduler<Policy>::getCompletedProcesses() const {
+    // Rebuilt on demand from the table instead of keeping a per-process list
+    // during the run. Streamed records are recycled, so there is no history.
+    std::vector<const Process*> completed;
+    if (source) {
+        return completed;
+    }
+    for (uint32_t i = 0; i < processes.size(); i++) {
+        if (processes[i].getCompletionTime() != -1) {
+            completed.push_back(&processes[i]);
+        }
+    }
+    std::stable_sort(completed.begin(), completed.end(),
+                     [](const Process* a, const Process* b) {
+                         return a->getCompletionTime() < b->getCompletionTime();
+                     });
+    return completed;
 }
 
-void Scheduler::displayProcessList() const {
-    Visualizer::displayProcessList(all_processes, "Process List");
+template <typename Policy>
+void BasicScheduler<Policy>::displayProcessList() const {
+    std::vector<const Process*> list;
+    list.reserve(processes.size());
+    for (uint32_t i = 0; i < processes.size(); i++) {
+        list.push_back(&processes[i]);
+    }
+    Visualizer::displayProcessList(list, "Process List");
 }
 
-void Scheduler::displayStatistics() const {
+template <typename Policy>
+void BasicScheduler<Policy>::displayStatistics() const {
     stats.display();
 }
 
-void Scheduler::displayGanttChart() const {
-    Visualizer::displayGanttChart(completed_processes);
+template <typename Policy>
+void BasicScheduler<Policy>::displayGanttChart() const {
+    Visualizer::displayGanttChart(execution_log);
 }
+
+template class BasicScheduler<LinearAging>;
+template class BasicScheduler<ExponentialAging>;
+template class BasicScheduler<StepAging<>>;
+template class BasicScheduler<CappedAging<>>;
+template class BasicScheduler<FixedPointAging>;
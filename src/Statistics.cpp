@@ -4,12 +4,43 @@
 #include <sstream>
 #include <algorithm>
 
+namespace {
+
+const double REPORTED_PERCENTILES[] = {50.0, 90.0, 99.0, 99.9};
+const char* const PERCENTILE_NAMES[] = {"p50", "p90", "p99", "p99.9"};
+
+void writePercentilesJson(std::ostream& out, const LatencyHistogram& histogram) {
+    out << "{";
+    for (int i = 0; i < 4; i++) {
+        out << "\"" << PERCENTILE_NAMES[i] << "\": " << histogram.percentile(REPORTED_PERCENTILES[i]) << ", ";
+    }
+    out << "\"max\": " << histogram.getMax() << "}";
+}
+
+}
+
+void LatencyBreakdown::record(const Process* process) {
+    waiting.record(process->getWaitingTime());
+    turnaround.record(process->getTurnaroundTime());
+    if (process->getResponseTime() >= 0) {
+        response.record(process->getResponseTime());
+    }
+}
+
+void LatencyBreakdown::merge(const LatencyBreakdown& other) {
+    waiting.merge(other.waiting);
+    response.merge(other.response);
+    turnaround.merge(other.turnaround);
+}
+
 Statistics::Statistics()
     : total_processes(0), completed_processes(0),
       total_waiting_time(0.0), total_turnaround_time(0.0),
       total_response_time(0.0), aging_events(0),
       max_waiting_time(0), total_burst_time(0),
-      total_execution_time(0) {
+      total_execution_time(0), preemptions(0), migrations(0),
+      rejected(0), shed(0),
+      slowdown_sum(0.0), slowdown_squares(0.0), starvation_threshold(0) {
 }
 
 void Statistics::recordProcess(const Process* process) {
@@ -27,6 +58,46 @@ void Statistics::recordProcess(const Process* process) {
 
     max_waiting_time = std::max(max_waiting_time, process->getWaitingTime());
     total_burst_time += process->getBurstTime();
+
+    latency.record(process);
+    by_priority[process->getBasePriority()].record(process);
+    // Against the time the process needed anyway: its CPU and I/O bursts
+    double service = static_cast<double>(process->getBurstTime() + process->getBlockedTime());
+    double slowdown = process->getTurnaroundTime() / service;
+    slowdown_sum += slowdown;
+    slowdown_squares += slowdown * slowdown;
+}
+
+void Statistics::merge(const Statistics& other) {
+    total_processes += other.total_processes;
+    completed_processes += other.completed_processes;
+    total_waiting_time += other.total_waiting_time;
+    total_turnaround_time += other.total_turnaround_time;
+    total_response_time += other.total_response_time;
+    aging_events += other.aging_events;
+    max_waiting_time = std::max(max_waiting_time, other.max_waiting_time);
+    total_burst_time += other.total_burst_time;
+    total_execution_time += other.total_execution_time;
+    preemptions += other.preemptions;
+    migrations += other.migrations;
+    rejected += other.rejected;
+    shed += other.shed;
+    if (other.core_busy_time.size() > core_busy_time.size()) {
+        core_busy_time.resize(other.core_busy_time.size(), 0);
+    }
+    for (size_t core = 0; core < other.core_busy_time.size(); core++) {
+        core_busy_time[core] += other.core_busy_time[core];
+    }
+    for (const auto& entry : other.priority_changes) {
+        priority_changes[entry.first] += entry.second;
+    }
+
+    latency.merge(other.latency);
+    for (const auto& entry : other.by_priority) {
+        by_priority[entry.first].merge(entry.second);
+    }
+    slowdown_sum += other.slowdown_sum;
+    slowdown_squares += other.slowdown_squares;
 }
 
 void Statistics::recordAgingEvent(int process_id) {
@@ -53,7 +124,40 @@ double Statistics::getAverageResponseTime() const {
 
 double Statistics::getCpuUtilization() const {
     if (total_execution_time == 0) return 0.0;
-    return (static_cast<double>(total_burst_time) / total_execution_time) * 100.0;
+    // Averaged over all cores in multi-core runs
+    return (static_cast<double>(total_burst_time) / (total_execution_time * getCoreCount())) * 100.0;
+}
+
+long long Statistics::getStarvationThreshold() const {
+    if (starvation_threshold > 0 || completed_processes == 0) {
+        return starvation_threshold;
+    }
+    return std::max(1LL, 10 * total_burst_time / completed_processes);
+}
+
+double Statistics::getStarvationRate() const {
+    if (completed_processes == 0) return 0.0;
+    return static_cast<double>(latency.waiting.countAbove(getStarvationThreshold())) /
+           latency.waiting.getCount();
+}
+
+double Statistics::getFairnessIndex() const {
+    if (completed_processes == 0 || slowdown_squares == 0.0) return 1.0;
+    return slowdown_sum * slowdown_sum / (completed_processes * slowdown_squares);
+}
+
+void Statistics::setCoreBusyTime(int core, long long busy_time) {
+    if (core < 0) return;
+    if (static_cast<size_t>(core) >= core_busy_time.size()) {
+        core_busy_time.resize(core + 1, 0);
+    }
+    core_busy_time[core] = busy_time;
+}
+
+double Statistics::getCoreUtilization(int core) const {
+    if (total_execution_time == 0 || core < 0 ||
+        static_cast<size_t>(core) >= core_busy_time.size()) return 0.0;
+    return (static_cast<double>(core_busy_time[core]) / total_execution_time) * 100.0;
 }
 
 void Statistics::reset() {
@@ -66,7 +170,16 @@ void Statistics::reset() {
     max_waiting_time = 0;
     total_burst_time = 0;
     total_execution_time = 0;
+    preemptions = 0;
+    migrations = 0;
+    rejected = 0;
+    shed = 0;
+    core_busy_time.clear();
     priority_changes.clear();
+    latency = LatencyBreakdown();
+    by_priority.clear();
+    slowdown_sum = 0.0;
+    slowdown_squares = 0.0;
 }
 
 void Statistics::display() const {
@@ -86,8 +199,54 @@ void Statistics::display() const {
     std::cout << "  Maximum Waiting Time:     " << max_waiting_time << " time units" << std::endl;
     std::cout << std::string(60, '-') << std::endl;
 
+    if (completed_processes > 0) {
+        std::cout << "  Percentiles:             ";
+        for (const char* name : PERCENTILE_NAMES) {
+            std::cout << std::setw(9) << name;
+        }
+        std::cout << std::endl;
+        const char* labels[] = {"  Waiting Time:          ", "  Response Time:         ", "  Turnaround Time:       "};
+        const LatencyHistogram* histograms[] = {&latency.waiting, &latency.response, &latency.turnaround};
+        for (int row = 0; row < 3; row++) {
+            std::cout << labels[row];
+            for (double p : REPORTED_PERCENTILES) {
+                std::cout << std::setw(9) << histograms[row]->percentile(p);
+            }
+            std::cout << std::endl;
+        }
+        std::cout << "  Starvation Rate:          " << getStarvationRate() * 100.0
+                  << "% (waiting > " << getStarvationThreshold() << ")" << std::endl;
+        std::cout << "  Fairness Index:           " << std::setprecision(4) << getFairnessIndex()
+                  << std::setprecision(2) << " (Jain, slowdown)" << std::endl;
+        std::cout << std::string(60, '-') << std::endl;
+
+        std::cout << "  Priority  Count     Wait p50   p99      p99.9    Max" << std::endl;
+        // Per base priority class
+        for (const auto& entry : by_priority) {
+            const LatencyHistogram& waiting = entry.second.waiting;
+            std::cout << "  " << std::left << std::setw(10) << entry.first << std::setw(10) << waiting.getCount()
+                      << std::setw(11) << waiting.percentile(50) << std::setw(9) << waiting.percentile(99)
+                      << std::setw(9) << waiting.percentile(99.9) << waiting.getMax() << std::right << std::endl;
+        }
+        std::cout << std::string(60, '-') << std::endl;
+    }
+
     std::cout << "  CPU Utilization:          " << getCpuUtilization() << "%" << std::endl;
     std::cout << "  Total Aging Events:       " << aging_events << std::endl;
+    if (preemptions > 0) {
+        std::cout << "  Preemptions:              " << preemptions << std::endl;
+    }
+    if (rejected > 0 || shed > 0) {
+        std::cout << "  Rejected (queue full):    " << rejected << std::endl;
+        std::cout << "  Shed (evicted):           " << shed << std::endl;
+    }
+    if (core_busy_time.size() > 1) {
+        std::cout << "  Migrations:               " << migrations << std::endl;
+        for (size_t core = 0; core < core_busy_time.size(); core++) {
+            std::cout << "  Core " << std::left << std::setw(3) << core << std::right
+                      << " Utilization:     " << getCoreUtilization(static_cast<int>(core)) << "%" << std::endl;
+        }
+    }
 
     if (!priority_changes.empty()) {
         std::cout << "  Processes with Priority Changes: " << priority_changes.size() << std::endl;
@@ -108,3 +267,81 @@ std::string Statistics::generateReport() const {
 
     return oss.str();
 }
+
+std::string Statistics::toJson() const {
+    std::ostringstream oss;
+
+    oss << std::fixed << std::setprecision(4);
+    oss << "{\"total_processes\": " << total_processes
+        << ", \"completed_processes\": " << completed_processes
+        << ", \"total_execution_time\": " << total_execution_time
+        << ", \"average_waiting_time\": " << getAverageWaitingTime()
+        << ", \"average_turnaround_time\": " << getAverageTurnaroundTime()
+        << ", \"average_response_time\": " << getAverageResponseTime()
+        << ", \"max_waiting_time\": " << max_waiting_time
+        << ", \"cpu_utilization\": " << getCpuUtilization()
+        << ", \"aging_events\": " << aging_events
+        << ", \"preemptions\": " << preemptions
+        << ", \"migrations\": " << migrations
+        << ", \"rejected\": " << rejected
+        << ", \"shed\": " << shed
+        << ", \"core_utilization\": [";
+    for (size_t core = 0; core < core_busy_time.size(); core++) {
+        oss << (core > 0 ? ", " : "") << getCoreUtilization(static_cast<int>(core));
+    }
+    oss << "]";
+
+    oss << ", \"latency\": {\"waiting\": ";
+    writePercentilesJson(oss, latency.waiting);
+    oss << ", \"response\": ";
+    writePercentilesJson(oss, latency.response);
+    oss << ", \"turnaround\": ";
+    writePercentilesJson(oss, latency.turnaround);
+    oss << "}";
+    oss << ", \"starvation_threshold\": " << getStarvationThreshold()
+        << ", \"starvation_rate\": " << getStarvationRate()
+        << ", \"fairness_index\": " << getFairnessIndex();
+
+    oss << ", \"by_priority\": [";
+    bool first = true;
+    for (const auto& entry : by_priority) {
+        oss << (first ? "" : ", ") << "{\"priority\": " << entry.first
+            << ", \"count\": " << entry.second.waiting.getCount() << ", \"waiting\": ";
+        writePercentilesJson(oss, entry.second.waiting);
+        oss << ", \"response\": ";
+        writePercentilesJson(oss, entry.second.response);
+        oss << ", \"turnaround\": ";
+        writePercentilesJson(oss, entry.second.turnaround);
+        oss << "}";
+        first = false;
+    }
+    oss << "]}";
+
+    return oss.str();
+}
+
+std::string Statistics::csvHeader() {
+    return "total_processes,completed_processes,total_execution_time,"
+           "average_waiting_time,average_turnaround_time,average_response_time,"
+           "max_waiting_time,cpu_utilization,aging_events,preemptions,migrations,rejected,shed,"
+           "waiting_p50,waiting_p90,waiting_p99,waiting_p999,response_p99,turnaround_p99,"
+           "starvation_rate,fairness_index";
+}
+
+std::string Statistics::toCsvRow() const {
+    std::ostringstream oss;
+
+    oss << std::fixed << std::setprecision(4);
+    oss << total_processes << ',' << completed_processes << ',' << total_execution_time << ','
+        << getAverageWaitingTime() << ',' << getAverageTurnaroundTime() << ','
+        << getAverageResponseTime() << ',' << max_waiting_time << ','
+        << getCpuUtilization() << ',' << aging_events << ','
+        << preemptions << ',' << migrations << ',' << rejected << ',' << shed;
+    for (double p : REPORTED_PERCENTILES) {
+        oss << ',' << latency.waiting.percentile(p);
+    }
+    oss << ',' << latency.response.percentile(99) << ',' << latency.turnaround.percentile(99)
+        << ',' << getStarvationRate() << ',' << getFairnessIndex();
+
+    return oss.str();
+}
@@ -0,0 +1,40 @@
+#include "Telemetry.h"
+#include <algorithm>
+#include <ostream>
+
+Telemetry::Telemetry(long long interval, size_t capacity)
+    : ring(interval > 0 ? std::max<size_t>(1, capacity) : 0), head(0), count(0), dropped(0),
+      interval(std::max(0LL, interval)), next_sample(0), interval_busy(0),
+      last_aging_events(0) {
+}
+
+void Telemetry::push(const TelemetrySample& sample) {
+    if (count < ring.size()) {
+        ring[(head + count++) % ring.size()] = sample;
+        return;
+    }
+    ring[head] = sample;
+    head = (head + 1) % ring.size();
+    dropped++;
+}
+
+std::vector<TelemetrySample> Telemetry::samples() const {
+    std::vector<TelemetrySample> ordered;
+    ordered.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        ordered.push_back(ring[(head + i) % ring.size()]);
+    }
+    return ordered;
+}
+
+void Telemetry::writeCsv(std::ostream& out) const {
+    out << "time,queue_length,min_priority,max_priority,aging_events,busy_ticks,cpu_busy\n";
+    for (size_t i = 0; i < count; i++) {
+        const TelemetrySample& s = ring[(head + i) % ring.size()];
+        out << s.time << ',' << s.queue_length << ','
+            << s.min_priority << ',' << s.max_priority << ','
+            << s.aging_events << ',' << s.busy_ticks << ','
+            << (s.cpu_busy ? 1 : 0) << '\n';
+    }
+    out.flush();
+}
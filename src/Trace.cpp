@@ -0,0 +1,422 @@
+#include "Trace.h"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+const char BINARY_MAGIC[8] = {'P', 'Q', 'T', 'R', 'A', 'C', 'E', '1'};
+const size_t BINARY_HEADER_SIZE = 16;
+const size_t BINARY_RECORD_SIZE = 20;
+const size_t RELEASE_ALIGNMENT = 1 << 16;   // A multiple of any page size in use
+
+// Result of parsing one CSV chunk
+struct ChunkResult {
+    std::vector<TraceRecord> records;
+    long long lines = 0;
+    long long error_line = 0;   // Line within the chunk, 0 = no error
+    std::string error;
+};
+
+bool isBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+// Parses a decimal integer field and the separator after it. No allocation,
+// no locale: this is the hot loop of a trace load.
+bool parseField(const char*& p, const char* end, long long& value, bool last) {
+    while (p < end && isBlank(*p)) p++;
+    bool negative = p < end && *p == '-';
+    if (negative) p++;
+    if (p == end || *p < '0' || *p > '9') {
+        return false;
+    }
+    long long v = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        if (v > (LLONG_MAX - 9) / 10) {
+            return false;
+        }
+        v = v * 10 + (*p++ - '0');
+    }
+    value = negative ? -v : v;
+    while (p < end && isBlank(*p)) p++;
+    if (last) {
+        return p == end;
+    }
+    if (p == end || *p != ',') {
+        return false;
+    }
+    p++;
+    return true;
+}
+
+void parseCsvChunk(const char* begin, const char* end, bool first_chunk, ChunkResult& out) {
+    out.records.reserve((end - begin) / 16);
+    const char* p = begin;
+    while (p < end) {
+        const char* eol = static_cast<const char*>(std::memchr(p, '\n', end - p));
+        if (!eol) eol = end;
+        out.lines++;
+
+        const char* field = p;
+        p = eol + 1;
+        while (field < eol && isBlank(*field)) field++;
+        if (field == eol || *field == '#') {
+            continue;
+        }
+        // Header line
+        if (first_chunk && out.lines == 1 && *field != '-' && (*field < '0' || *field > '9')) {
+            continue;
+        }
+
+        // The I/O columns are optional
+        long long id, priority, arrival, burst, io_interval = 0, io_time = 0;
+        bool io = std::count(field, eol, ',') > 3;
+        if (!parseField(field, eol, id, false) || !parseField(field, eol, priority, false) ||
+            !parseField(field, eol, arrival, false) || !parseField(field, eol, burst, !io) ||
+            (io && (!parseField(field, eol, io_interval, false) ||
+                    !parseField(field, eol, io_time, true)))) {
+            out.error_line = out.lines;
+            out.error = "expected id,priority,arrival,burst[,io_interval,io_time]";
+            return;
+        }
+        if (id < INT_MIN || id > INT_MAX || priority < 0 || priority > INT_MAX ||
+            arrival < 0 || burst < 1 || burst > INT_MAX || io_interval < 0 || io_interval > INT_MAX ||
+            io_time < 0 || io_time > INT_MAX || (io_interval > 0 && io_time < 1)) {
+            out.error_line = out.lines;
+            out.error = "value out of range";
+            return;
+        }
+        out.records.push_back({static_cast<int>(id), static_cast<int>(priority), arrival,
+                               static_cast<int>(burst), static_cast<int>(io_interval),
+                               static_cast<int>(io_time)});
+    }
+}
+
+// Binary fields are little-endian whatever the host; on little-endian
+// hosts the compiler turns these loops into plain loads and stores
+template <typename T>
+T load(const char* p) {
+    using Bits = std::make_unsigned_t<T>;
+    Bits value = 0;
+    for (size_t i = 0; i < sizeof(T); i++) {
+        value |= static_cast<Bits>(static_cast<unsigned char>(p[i])) << (8 * i);
+    }
+    return static_cast<T>(value);
+}
+
+template <typename T>
+void store(char* p, T value) {
+    using Bits = std::make_unsigned_t<T>;
+    Bits bits = static_cast<Bits>(value);
+    for (size_t i = 0; i < sizeof(T); i++) {
+        p[i] = static_cast<char>((bits >> (8 * i)) & 0xFF);
+    }
+}
+
+}
+
+TraceReader::TraceReader(int threads, size_t chunk_bytes)
+    : data(nullptr), size(0),
+#ifdef _WIN32
+      file_handle(nullptr), mapping_handle(nullptr),
+#else
+      fd(-1),
+#endif
+      format(TraceFormat::Auto), offset(0), released(0), lines_before(0),
+      threads(threads > 0 ? threads : std::max(1u, std::thread::hardware_concurrency())),
+      chunk_bytes(std::max<size_t>(chunk_bytes, RELEASE_ALIGNMENT)), position(0),
+      records_read(0), late_records(0), last_arrival(LLONG_MIN) {
+}
+
+TraceReader::~TraceReader() {
+    close();
+}
+
+bool TraceReader::open(const std::string& file_path, TraceFormat requested) {
+    close();
+    path = file_path;
+    error.clear();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        error = "cannot open " + path;
+        return false;
+    }
+    file_handle = file;
+    LARGE_INTEGER file_size;
+    GetFileSizeEx(file, &file_size);
+    size = static_cast<size_t>(file_size.QuadPart);
+    if (size > 0) {
+        mapping_handle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping_handle) {
+            data = static_cast<const char*>(MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0));
+        }
+        if (!data) {
+            error = "cannot map " + path;
+            close();
+            return false;
+        }
+    }
+#else
+    fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error = "cannot open " + path;
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        error = "cannot stat " + path;
+        close();
+        return false;
+    }
+    size = static_cast<size_t>(info.st_size);
+    if (size > 0) {
+        void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) {
+            error = "cannot map " + path;
+            close();
+            return false;
+        }
+        data = static_cast<const char*>(mapped);
+        madvise(mapped, size, MADV_SEQUENTIAL);
+    }
+#endif
+
+    bool has_magic = size >= sizeof(BINARY_MAGIC) &&
+                     std::memcmp(data, BINARY_MAGIC, sizeof(BINARY_MAGIC)) == 0;
+    format = requested == TraceFormat::Auto
+                 ? (has_magic ? TraceFormat::Binary : TraceFormat::Csv)
+                 : requested;
+
+    if (format == TraceFormat::Binary) {
+        if (!has_magic || size < BINARY_HEADER_SIZE) {
+            error = path + ": not a binary trace";
+            return false;
+        }
+        uint64_t count = load<uint64_t>(data + sizeof(BINARY_MAGIC));
+        if ((size - BINARY_HEADER_SIZE) / BINARY_RECORD_SIZE != count ||
+            (size - BINARY_HEADER_SIZE) % BINARY_RECORD_SIZE != 0) {
+            error = path + ": truncated binary trace";
+            return false;
+        }
+        offset = BINARY_HEADER_SIZE;
+    }
+    return true;
+}
+
+void TraceReader::close() {
+#ifdef _WIN32
+    if (data) UnmapViewOfFile(data);
+    if (mapping_handle) CloseHandle(mapping_handle);
+    if (file_handle) CloseHandle(file_handle);
+    file_handle = nullptr;
+    mapping_handle = nullptr;
+#else
+    if (data) munmap(const_cast<char*>(data), size);
+    if (fd >= 0) ::close(fd);
+    fd = -1;
+#endif
+    data = nullptr;
+    size = 0;
+    offset = 0;
+    released = 0;
+    lines_before = 0;
+    window.clear();
+    position = 0;
+    records_read = 0;
+    late_records = 0;
+    last_arrival = LLONG_MIN;
+}
+
+const TraceRecord* TraceReader::peek() {
+    if (position == window.size() && !refill()) {
+        return nullptr;
+    }
+    return &window[position];
+}
+
+void TraceReader::advance() {
+    const TraceRecord& record = window[position++];
+    if (record.arrival < last_arrival) {
+        late_records++;
+    } else {
+        last_arrival = record.arrival;
+    }
+    records_read++;
+}
+
+bool TraceReader::next(TraceRecord& record) {
+    const TraceRecord* head = peek();
+    if (!head) {
+        return false;
+    }
+    record = *head;
+    advance();
+    return true;
+}
+
+bool TraceReader::refill() {
+    window.clear();
+    position = 0;
+
+    // A window can be all blank lines or comments; keep going until records or EOF
+    while (window.empty()) {
+        if (!data || failed() || offset >= size) {
+            return false;
+        }
+        bool ok = format == TraceFormat::Binary ? refillBinary() : refillCsv();
+        releaseConsumed();
+        if (!ok) {
+            window.clear();
+            return false;
+        }
+    }
+
+    // Sorting per window tolerates local disorder in the trace
+    auto by_arrival = [](const TraceRecord& a, const TraceRecord& b) { return a.arrival < b.arrival; };
+    if (!std::is_sorted(window.begin(), window.end(), by_arrival)) {
+        std::stable_sort(window.begin(), window.end(), by_arrival);
+    }
+    return true;
+}
+
+bool TraceReader::refillCsv() {
+    // Cut the next threads * chunk_bytes into chunks ending on a newline
+    std::vector<std::pair<size_t, size_t>> chunks;
+    size_t begin = offset;
+    for (int t = 0; t < threads && begin < size; t++) {
+        size_t end = std::min(size, begin + chunk_bytes);
+        if (end < size) {
+            const char* eol = static_cast<const char*>(std::memchr(data + end, '\n', size - end));
+            end = eol ? static_cast<size_t>(eol - data) + 1 : size;
+        }
+        chunks.emplace_back(begin, end);
+        begin = end;
+    }
+
+    std::vector<ChunkResult> results(chunks.size());
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < chunks.size(); i++) {
+        workers.emplace_back([&, i]() {
+            parseCsvChunk(data + chunks[i].first, data + chunks[i].second, false, results[i]);
+        });
+    }
+    parseCsvChunk(data + chunks[0].first, data + chunks[0].second, chunks[0].first == 0, results[0]);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    size_t total = 0;
+    for (const auto& result : results) {
+        total += result.records.size();
+    }
+    window.reserve(total);
+    for (const auto& result : results) {
+        if (!result.error.empty()) {
+            error = path + ":" + std::to_string(lines_before + result.error_line) + ": " + result.error;
+            return false;
+        }
+        window.insert(window.end(), result.records.begin(), result.records.end());
+        lines_before += result.lines;
+    }
+    offset = begin;
+    return true;
+}
+
+bool TraceReader::refillBinary() {
+    size_t remaining = (size - offset) / BINARY_RECORD_SIZE;
+    size_t count = std::min(remaining, BINARY_WINDOW_RECORDS);
+    window.resize(count);
+    const char* p = data + offset;
+    for (size_t i = 0; i < count; i++, p += BINARY_RECORD_SIZE) {
+        TraceRecord& record = window[i];
+        record.id = load<int32_t>(p);
+        record.priority = load<int32_t>(p + 4);
+        record.arrival = load<int64_t>(p + 8);
+        record.burst = load<int32_t>(p + 16);
+        if (record.priority < 0 || record.arrival < 0 || record.burst < 1) {
+            error = path + ": record " + std::to_string(records_read + i + 1) + ": value out of range";
+            return false;
+        }
+    }
+    offset += count * BINARY_RECORD_SIZE;
+    return true;
+}
+
+void TraceReader::releaseConsumed() {
+    // Drop parsed pages from the working set; they are clean file pages, so
+    // this frees memory without I/O
+    size_t boundary = offset / RELEASE_ALIGNMENT * RELEASE_ALIGNMENT;
+    if (boundary <= released) {
+        return;
+    }
+#ifdef _WIN32
+    // VirtualUnlock on an unlocked range trims it from the working set
+    VirtualUnlock(const_cast<char*>(data) + released, boundary - released);
+#else
+    madvise(const_cast<char*>(data) + released, boundary - released, MADV_DONTNEED);
+#endif
+    released = boundary;
+}
+
+TraceWriter::TraceWriter() : file(nullptr), count(0) {
+}
+
+TraceWriter::~TraceWriter() {
+    close();
+}
+
+bool TraceWriter::open(const std::string& path) {
+    close();
+    count = 0;
+    file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+    char header[BINARY_HEADER_SIZE] = {};
+    std::memcpy(header, BINARY_MAGIC, sizeof(BINARY_MAGIC));
+    return std::fwrite(header, 1, sizeof(header), file) == sizeof(header);
+}
+
+bool TraceWriter::write(const TraceRecord& record) {
+    if (record.io_interval > 0) {
+        return false;
+    }
+    char buffer[BINARY_RECORD_SIZE];
+    store<int32_t>(buffer, record.id);
+    store<int32_t>(buffer + 4, record.priority);
+    store<int64_t>(buffer + 8, record.arrival);
+    store<int32_t>(buffer + 16, record.burst);
+    if (std::fwrite(buffer, 1, sizeof(buffer), file) != sizeof(buffer)) {
+        return false;
+    }
+    count++;
+    return true;
+}
+
+bool TraceWriter::close() {
+    if (!file) {
+        return true;
+    }
+    char encoded[sizeof(count)];
+    store<uint64_t>(encoded, count);
+    bool ok = std::fseek(file, sizeof(BINARY_MAGIC), SEEK_SET) == 0 &&
+              std::fwrite(encoded, sizeof(encoded), 1, file) == 1;
+    ok = std::fclose(file) == 0 && ok;
+    file = nullptr;
+    return ok;
+}
@@ -1,51 +1,116 @@
 #include "Visualizer.h"
+#include <algorithm>
+#include <cstdlib>
 #include <iostream>
 #include <iomanip>
 #include <sstream>
+#include <unordered_map>
 
 #ifdef _WIN32
 #include <windows.h>
 #else
-#include <cstdlib>
+#include <sys/ioctl.h>
+#include <unistd.h>
 #endif
 
+namespace {
+
+// Beyond this many processes the chart shows cores instead
+const size_t MAX_PROCESS_ROWS = 24;
+
+// Space taken by a row's label and trailing summary
+const int ROW_MARGIN = 30;
+const int MIN_CHART_COLUMNS = 20;
+
+// Columns cover [column * scale, (column + 1) * scale); adds the overlap of
+// [start, end) with each column to busy
+void addSlice(std::vector<long long>& busy, long long scale, long long start, long long end) {
+    for (long long column = start / scale; column * scale < end; column++) {
+        long long from = std::max(start, column * scale);
+        long long to = std::min(end, (column + 1) * scale);
+        busy[static_cast<size_t>(column)] += to - from;
+    }
+}
+
+std::string padLabel(const std::string& label, size_t width) {
+    return label + std::string(width > label.size() ? width - label.size() : 0, ' ');
+}
+
+}
+
+bool Visualizer::enableAnsi() {
+#ifdef _WIN32
+    // Windows 10+ consoles understand escape sequences once asked to
+    HANDLE console = GetStdHandle(STD_OUTPUT_HANDLE);
+    DWORD mode = 0;
+    if (!GetConsoleMode(console, &mode)) {
+        return false;
+    }
+    return (mode & ENABLE_VIRTUAL_TERMINAL_PROCESSING) ||
+           SetConsoleMode(console, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+#else
+    return true;
+#endif
+}
+
 void Visualizer::clearScreen() {
+    // Cursor home + erase display, instead of starting a clear/cls process
+    static const bool ansi = enableAnsi();
+    if (ansi) {
+        std::cout << "\x1b[H\x1b[2J" << std::flush;
+        return;
+    }
 #ifdef _WIN32
     system("cls");
-#else
-    system("clear");
 #endif
 }
 
 void Visualizer::printHeader(const std::string& title) {
     printSeparator('=', 60);
-    std::cout << "  " << title << std::endl;
+    std::cout << "  " << title << '\n';
     printSeparator('=', 60);
 }
 
 void Visualizer::printSeparator(char c, int width) {
-    std::cout << std::string(width, c) << std::endl;
+    std::cout << std::string(width, c) << '\n';
+}
+
+int Visualizer::terminalWidth() {
+#ifdef _WIN32
+    CONSOLE_SCREEN_BUFFER_INFO info;
+    if (GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &info)) {
+        return info.srWindow.Right - info.srWindow.Left + 1;
+    }
+#else
+    struct winsize size;
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) == 0 && size.ws_col > 0) {
+        return size.ws_col;
+    }
+#endif
+    const char* columns = std::getenv("COLUMNS");
+    int width = columns ? std::atoi(columns) : 0;
+    return width > 0 ? width : 80;
 }
 
 void Visualizer::displayProcess(const Process* process, bool detailed) {
     if (!process) {
-        std::cout << "  [NULL Process]" << std::endl;
+        std::cout << "  [NULL Process]" << '\n';
         return;
     }
 
     if (detailed) {
-        std::cout << "  " << process->toDetailedString() << std::endl;
+        std::cout << "  " << process->toDetailedString() << '\n';
     } else {
-        std::cout << "  " << process->toString() << std::endl;
+        std::cout << "  " << process->toString() << '\n';
     }
 }
 
-void Visualizer::displayProcessList(const std::vector<Process*>& processes, const std::string& title) {
-    std::cout << "\n" << title << " (" << processes.size() << " processes):" << std::endl;
+void Visualizer::displayProcessList(const std::vector<const Process*>& processes, const std::string& title) {
+    std::cout << "\n" << title << " (" << processes.size() << " processes):" << '\n';
     printSeparator('-', 60);
 
     if (processes.empty()) {
-        std::cout << "  [No processes]" << std::endl;
+        std::cout << "  [No processes]" << '\n';
         return;
     }
 
@@ -56,7 +121,7 @@ void Visualizer::displayProcessList(const std::vector<Process*>& processes, cons
 }
 
 void Visualizer::displayQueue(const PriorityQueue& queue, const std::string& title) {
-    std::cout << "\n" << title << ":" << std::endl;
+    std::cout << "\n" << title << ":" << '\n';
     printSeparator('-', 60);
     queue.display();
     printSeparator('-', 60);
@@ -78,70 +143,127 @@ void Visualizer::displayProgressBar(int current, int total, int width) {
     std::cout.flush();
 }
 
-void Visualizer::displayTimeStep(int current_time, const std::string& event) {
+void Visualizer::displayTimeStep(long long current_time, const std::string& event) {
     std::cout << "\n[Time " << std::setw(3) << current_time << "] ";
     if (!event.empty()) {
         std::cout << event;
     }
-    std::cout << std::endl;
+    std::cout << '\n';
 }
 
-void Visualizer::displayGanttChart(const std::vector<Process*>& processes) {
-    if (processes.empty()) {
+void Visualizer::displayGanttChart(const ExecutionLog& log, int width) {
+    if (log.empty()) {
         return;
     }
+    const std::vector<ExecutionSlice>& slices = log.getSlices();
 
-    std::cout << "\nGantt Chart:" << std::endl;
-    printSeparator('-', 60);
+    // Rows: processes in order of first dispatch, or cores for large runs
+    std::unordered_map<int, size_t> process_row;
+    std::vector<int> row_ids;
+    bool by_process = true;
+    int cores = 0;
+    for (const auto& slice : slices) {
+        cores = std::max(cores, slice.core + 1);
+        if (by_process && process_row.emplace(slice.process_id, row_ids.size()).second) {
+            row_ids.push_back(slice.process_id);
+            by_process = row_ids.size() <= MAX_PROCESS_ROWS;
+        }
+    }
+    size_t rows = by_process ? row_ids.size() : static_cast<size_t>(cores);
 
-    int max_time = 0;
-    for (const auto* process : processes) {
-        if (process->getCompletionTime() > max_time) {
-            max_time = process->getCompletionTime();
+    // Downsample: each column covers scale time units
+    long long end_time = log.getEndTime();
+    int columns = std::max(MIN_CHART_COLUMNS, (width > 0 ? width : terminalWidth()) - ROW_MARGIN);
+    long long scale = std::max(1LL, (end_time + columns - 1) / columns);
+    size_t used = static_cast<size_t>((end_time + scale - 1) / scale);
+
+    std::vector<std::vector<long long>> busy(rows, std::vector<long long>(used, 0));
+    std::vector<long long> first(rows, -1), last(rows, 0), count(rows, 0);
+    for (const auto& slice : slices) {
+        size_t row = by_process ? process_row[slice.process_id] : static_cast<size_t>(slice.core);
+        addSlice(busy[row], scale, slice.start, slice.end);
+        if (first[row] == -1) {
+            first[row] = slice.start;
         }
+        last[row] = slice.end;
+        count[row]++;
     }
 
-    for (const auto* process : processes) {
-        if (!process->hasStarted()) continue;
+    std::vector<std::string> labels(rows);
+    size_t label_width = 0;
+    for (size_t row = 0; row < rows; row++) {
+        labels[row] = by_process ? "P" + std::string(row_ids[row] < 10 ? "0" : "") + std::to_string(row_ids[row])
+                                 : "Core " + std::to_string(row);
+        label_width = std::max(label_width, labels[row].size());
+    }
 
-        std::cout << "  P" << std::setw(2) << std::setfill('0') << process->getId()
-                  << " |";
+    std::cout << "\nGantt Chart";
+    if (scale > 1) {
+        std::cout << " (1 column = " << scale << " time units)";
+    }
+    std::cout << ":" << '\n';
+    printSeparator('-', 60);
 
-        for (int t = 0; t < max_time; t++) {
-            if (t >= process->getStartTime() && t < process->getCompletionTime()) {
-                std::cout << "=";
-            } else {
-                std::cout << " ";
+    for (size_t row = 0; row < rows; row++) {
+        // '=' busy for the whole column, then '-', ':' and '.' for at least
+        // half, a quarter and any part of it
+        std::string bar(used, ' ');
+        for (size_t column = 0; column < used; column++) {
+            long long span = std::min(scale, end_time - static_cast<long long>(column) * scale);
+            long long b = busy[row][column];
+            if (b > 0) {
+                bar[column] = b >= span ? '=' : 2 * b >= span ? '-' : 4 * b >= span ? ':' : '.';
             }
         }
-        std::cout << "| (" << process->getStartTime()
-                  << "-" << process->getCompletionTime() << ")" << std::endl;
+        std::cout << "  " << padLabel(labels[row], label_width) << " |" << bar << "| ";
+        if (by_process) {
+            std::cout << "(" << first[row] << "-" << last[row];
+            if (count[row] > 1) {
+                std::cout << ", " << count[row] << " slices";
+            }
+            std::cout << ")";
+        } else {
+            long long total = 0;
+            for (long long b : busy[row]) {
+                total += b;
+            }
+            std::cout << std::fixed << std::setprecision(1)
+                      << 100.0 * total / std::max(1LL, end_time) << "% busy"
+                      << std::defaultfloat << std::setprecision(6);
+        }
+        std::cout << '\n';
     }
 
-    std::cout << "     0";
-    for (int t = 5; t <= max_time; t += 5) {
-        std::cout << std::setw(5) << t;
+    // Time axis: the start time of every tick-th column
+    std::string axis(used + 1, ' ');
+    size_t tick = std::max<size_t>(5, std::to_string(end_time).size() + 2);
+    for (size_t column = 0; column <= used; column += tick) {
+        std::string time = std::to_string(static_cast<long long>(column) * scale);
+        if (column + time.size() > axis.size()) {
+            break;
+        }
+        axis.replace(column, time.size(), time);
     }
-    std::cout << std::endl;
+    std::cout << "  " << std::string(label_width + 2, ' ') << axis << '\n';
     printSeparator('-', 60);
 }
 
-void Visualizer::displayExecutionSnapshot(int current_time,
+void Visualizer::displayExecutionSnapshot(long long current_time,
                                          const Process* running_process,
                                          const PriorityQueue& queue,
                                          int completed_count) {
-    std::cout << "\n" << std::string(60, '-') << std::endl;
+    std::cout << "\n" << std::string(60, '-') << '\n';
     std::cout << "[Time: " << current_time << "] ";
 
     if (running_process) {
         std::cout << "Running: " << running_process->toString()
                   << " (Remaining: " << running_process->getRemainingTime() << ")"
-                  << std::endl;
+                  << '\n';
     } else {
-        std::cout << "CPU Idle" << std::endl;
+        std::cout << "CPU Idle" << '\n';
     }
 
-    std::cout << "Completed: " << completed_count << " | Queue Size: " << queue.size() << std::endl;
+    std::cout << "Completed: " << completed_count << " | Queue Size: " << queue.size() << '\n';
 
     if (!queue.isEmpty()) {
         std::cout << "Queue: ";
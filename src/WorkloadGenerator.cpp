@@ -0,0 +1,269 @@
+#include "WorkloadGenerator.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace {
+
+uint64_t splitmix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Substream identifiers within a block
+const uint64_t GAP_STREAM = 0;
+const uint64_t ATTRIBUTE_STREAM = 1;
+const uint64_t IO_STREAM = 2;          // Own stream: I/O never shifts the other attributes
+
+// xoshiro256**, seeded per (seed, block, stream). Distributions are computed
+// here rather than with <random>, whose distributions differ between
+// standard libraries.
+class Random {
+private:
+    uint64_t s[4];
+
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+public:
+    Random(uint64_t seed, uint64_t block, uint64_t stream) {
+        uint64_t state = seed;
+        state = splitmix64(state) ^ (block * 0xD1B54A32D192ED03ULL);
+        state = splitmix64(state) ^ (stream * 0xABC98388FB8FAC03ULL);
+        for (auto& word : s) {
+            word = splitmix64(state);
+        }
+    }
+
+    uint64_t next() {
+        uint64_t result = rotl(s[1] * 5, 7) * 9;
+        uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    // [0, 1)
+    double uniform() { return (next() >> 11) * 0x1.0p-53; }
+
+    // Exponential with the given mean. log1p() is not correctly rounded,
+    // so the result can differ by an ulp between libms
+    double exponential(double mean) { return -mean * std::log1p(-uniform()); }
+
+    int uniformInt(int lo, int hi) {
+        long long span = static_cast<long long>(hi) - lo + 1;
+        return static_cast<int>(std::min<long long>(hi, lo + static_cast<long long>(uniform() * span)));
+    }
+};
+
+}
+
+WorkloadGenerator::WorkloadGenerator(const WorkloadSpec& workload, int threads)
+    : spec(workload),
+      threads(threads > 0 ? threads : std::max(1u, std::thread::hardware_concurrency())),
+      total_duration(0.0), next_block(0), offset(0.0), window_block(0), position(0),
+      generated(0) {
+    spec.count = std::max(0LL, spec.count);
+    spec.max_priority = std::max(1, spec.max_priority);
+    spec.min_burst = std::max(1, spec.min_burst);
+    spec.max_burst = std::max(spec.min_burst, spec.max_burst);
+    spec.max_io_interval = std::max(1, spec.max_io_interval);
+    spec.max_io_time = std::max(1, spec.max_io_time);
+
+    double weight_sum = 0.0;
+    for (int p = 1; p <= spec.max_priority; p++) {
+        weight_sum += std::pow(static_cast<double>(spec.max_priority - p + 1), -spec.priority_skew);
+        priority_cdf.push_back(weight_sum);
+    }
+    for (auto& c : priority_cdf) {
+        c /= weight_sum;
+    }
+
+    if (spec.arrivals == ArrivalPattern::Uniform) {
+        // Sorted uniform points are normalised partial sums of exponential
+        // gaps, so the total must be known first: one pass over all blocks'
+        // gaps (plus a final gap past the last job)
+        long long blocks = blockCount();
+        std::vector<double> durations(blocks);
+        std::vector<std::thread> workers;
+        for (int t = 0; t < this->threads && t < blocks; t++) {
+            workers.emplace_back([&, t]() {
+                for (long long b = t; b < blocks; b += this->threads) {
+                    durations[b] = generateGaps(b, nullptr);
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        block_offsets.reserve(blocks);
+        for (double duration : durations) {
+            block_offsets.push_back(total_duration);
+            total_duration += duration;
+        }
+        total_duration += Random(spec.seed, blocks, GAP_STREAM).exponential(1.0);
+    }
+}
+
+long long WorkloadGenerator::blockCount() const {
+    return (spec.count + BLOCK_SIZE - 1) / BLOCK_SIZE;
+}
+
+double WorkloadGenerator::generateGaps(long long block, std::vector<double>* times) const {
+    long long n = std::min(BLOCK_SIZE, spec.count - block * BLOCK_SIZE);
+    Random random(spec.seed, block, GAP_STREAM);
+    if (times) {
+        times->resize(n);
+    }
+
+    // Bursty: each block starts in the stationary phase distribution, so
+    // blocks stay independent
+    double leave_burst = 1.0 / std::max(1.0, spec.burst_length);
+    double share = std::min(std::max(spec.burst_share, 0.0), 0.999);
+    double enter_burst = std::min(1.0, leave_burst * share / (1.0 - share));
+    bool in_burst = spec.arrivals == ArrivalPattern::Bursty && random.uniform() < share;
+
+    double time = 0.0;
+    for (long long i = 0; i < n; i++) {
+        switch (spec.arrivals) {
+            case ArrivalPattern::Uniform:
+                time += random.exponential(1.0);
+                break;
+            case ArrivalPattern::Poisson:
+                time += random.exponential(spec.mean_interarrival);
+                break;
+            case ArrivalPattern::Bursty:
+                time += random.exponential(in_burst ? spec.mean_interarrival / spec.burst_rate
+                                                    : spec.mean_interarrival);
+                in_burst = random.uniform() < (in_burst ? 1.0 - leave_burst : enter_burst);
+                break;
+        }
+        if (times) {
+            (*times)[i] = time;
+        }
+    }
+    return time;
+}
+
+void WorkloadGenerator::generateBlock(long long block, Block& out) const {
+    out.duration = generateGaps(block, &out.times);
+
+    Random random(spec.seed, block, ATTRIBUTE_STREAM);
+    Random io_random(spec.seed, block, IO_STREAM);
+    long long first_id = block * BLOCK_SIZE + 1;
+    out.records.resize(out.times.size());
+    for (size_t i = 0; i < out.records.size(); i++) {
+        TraceRecord& record = out.records[i];
+        record.id = static_cast<int>(first_id + i);
+
+        double u = random.uniform();
+        record.priority = static_cast<int>(
+            std::upper_bound(priority_cdf.begin(), priority_cdf.end() - 1, u) - priority_cdf.begin()) + 1;
+
+        if (spec.bursts == BurstDistribution::Pareto) {
+            double burst = spec.min_burst / std::pow(1.0 - random.uniform(), 1.0 / spec.pareto_alpha);
+            record.burst = burst >= spec.max_burst ? spec.max_burst : static_cast<int>(burst);
+        } else {
+            record.burst = random.uniformInt(spec.min_burst, spec.max_burst);
+        }
+
+        record.io_interval = 0;
+        record.io_time = 0;
+        if (spec.io_share > 0.0) {
+            double u_io = io_random.uniform();
+            int interval = io_random.uniformInt(1, spec.max_io_interval);
+            int io_time = io_random.uniformInt(1, spec.max_io_time);
+            if (u_io < spec.io_share) {
+                record.io_interval = interval;
+                record.io_time = io_time;
+            }
+        }
+
+        // Uniform block starts are precomputed, so those arrivals are final;
+        // the others are shifted by the block start in refill()
+        if (spec.arrivals == ArrivalPattern::Uniform) {
+            double t = (block_offsets[block] + out.times[i]) * (spec.horizon + 1) / total_duration;
+            record.arrival = std::min(static_cast<long long>(t), spec.horizon);
+        }
+    }
+}
+
+bool WorkloadGenerator::refill() {
+    window_block = 0;
+    position = 0;
+    long long blocks = std::min<long long>(threads, blockCount() - next_block);
+    if (blocks <= 0) {
+        window.clear();
+        return false;
+    }
+
+    window.resize(blocks);
+    std::vector<std::thread> workers;
+    for (long long b = 1; b < blocks; b++) {
+        workers.emplace_back([this, b]() { generateBlock(next_block + b, window[b]); });
+    }
+    generateBlock(next_block, window[0]);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    // Block starts follow from the durations of all earlier blocks
+    if (spec.arrivals != ArrivalPattern::Uniform) {
+        for (auto& block : window) {
+            for (size_t i = 0; i < block.records.size(); i++) {
+                block.records[i].arrival = static_cast<long long>(offset + block.times[i]);
+            }
+            offset += block.duration;
+        }
+    }
+    next_block += blocks;
+    return true;
+}
+
+const TraceRecord* WorkloadGenerator::peek() {
+    while (window_block < window.size() && position == window[window_block].records.size()) {
+        window_block++;
+        position = 0;
+    }
+    if (window_block == window.size() && !refill()) {
+        return nullptr;
+    }
+    return &window[window_block].records[position];
+}
+
+void WorkloadGenerator::advance() {
+    position++;
+    generated++;
+}
+
+bool WorkloadGenerator::next(TraceRecord& record) {
+    const TraceRecord* head = peek();
+    if (!head) {
+        return false;
+    }
+    record = *head;
+    advance();
+    return true;
+}
+
+void WorkloadGenerator::reset() {
+    next_block = 0;
+    offset = 0.0;
+    window.clear();
+    window_block = 0;
+    position = 0;
+    generated = 0;
+}
+
+void WorkloadGenerator::generate(ProcessTable& table) {
+    TraceRecord record;
+    while (next(record)) {
+        table.add(Process(record.id, record.priority, record.arrival, record.burst,
+                          record.io_interval, record.io_time));
+    }
+}
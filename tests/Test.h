@@ -0,0 +1,61 @@
+#ifndef TEST_H
+#define TEST_H
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Minimal test harness for the tests/ programs.
+//
+// TEST(name) defines and registers a case; CHECK and CHECK_EQ record a
+// failure and let the case go on, so one run reports every mismatch.
+// tests/main.cpp runs the cases in registration order and exits non-zero
+// if any check failed.
+
+struct TestCase {
+    const char* name;
+    void (*fn)();
+};
+
+inline std::vector<TestCase>& testRegistry() {
+    static std::vector<TestCase> cases;
+    return cases;
+}
+
+inline int& testFailures() {
+    static int failures = 0;
+    return failures;
+}
+
+struct TestRegistrar {
+    TestRegistrar(const char* name, void (*fn)()) { testRegistry().push_back({name, fn}); }
+};
+
+inline void testFail(const char* file, int line, const std::string& what) {
+    testFailures()++;
+    std::cerr << file << ":" << line << ": check failed: " << what << std::endl;
+}
+
+#define TEST(name)                                              \
+    static void name();                                         \
+    static TestRegistrar name##_registrar(#name, name);         \
+    static void name()
+
+#define CHECK(cond)                                             \
+    do {                                                        \
+        if (!(cond)) testFail(__FILE__, __LINE__, #cond);       \
+    } while (0)
+
+#define CHECK_EQ(a, b)                                          \
+    do {                                                        \
+        auto check_a = (a);                                     \
+        auto check_b = (b);                                     \
+        if (!(check_a == check_b)) {                            \
+            std::ostringstream check_out;                       \
+            check_out << #a " == " #b " (" << check_a << " vs " << check_b << ")"; \
+            testFail(__FILE__, __LINE__, check_out.str());      \
+        }                                                       \
+    } while (0)
+
+#endif // TEST_H
@@ -0,0 +1,17 @@
+// Runs every registered test case (see Test.h)
+
+#include "Test.h"
+
+int main() {
+    int failed_cases = 0;
+    for (const TestCase& test : testRegistry()) {
+        int before = testFailures();
+        test.fn();
+        bool passed = testFailures() == before;
+        failed_cases += !passed;
+        std::cout << (passed ? "[pass] " : "[FAIL] ") << test.name << std::endl;
+    }
+    std::cout << testRegistry().size() - failed_cases << "/" << testRegistry().size()
+              << " test cases passed" << std::endl;
+    return failed_cases == 0 ? 0 : 1;
+}
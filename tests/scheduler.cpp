@@ -0,0 +1,180 @@
+// Engine equivalences: the event-driven run() against the tick-based
+// reference, Lazy against Eager, bucket against heap, and one simulated core
+// against the single-core scheduler. Each compares per-process schedules.
+
+#include "MultiCoreScheduler.h"
+#include "Scheduler.h"
+#include "Test.h"
+#include <map>
+#include <tuple>
+
+namespace {
+
+// Process id -> (start, completion, waiting)
+using Schedule = std::map<int, std::tuple<long long, long long, long long>>;
+
+Schedule scheduleOf(const std::vector<const Process*>& completed) {
+    Schedule schedule;
+    for (const Process* p : completed) {
+        schedule[p->getId()] = std::make_tuple(p->getStartTime(), p->getCompletionTime(), p->getWaitingTime());
+    }
+    return schedule;
+}
+
+// First process whose schedule differs, -1 if none
+int firstDifference(const Schedule& a, const Schedule& b) {
+    if (a.size() != b.size()) {
+        return a.size() < b.size() ? 0 : 1;
+    }
+    for (const auto& entry : a) {
+        auto other = b.find(entry.first);
+        if (other == b.end() || other->second != entry.second) {
+            return entry.first;
+        }
+    }
+    return -1;
+}
+
+WorkloadSpec smallWorkload(uint64_t seed, double io_share = 0.0) {
+    WorkloadSpec spec;
+    spec.seed = seed;
+    spec.count = 300;
+    spec.arrivals = ArrivalPattern::Uniform;
+    spec.horizon = 600;
+    spec.max_priority = 10;
+    spec.max_burst = 8;
+    spec.io_share = io_share;
+    return spec;
+}
+
+struct Setup {
+    double factor = 0.1;
+    AgingMode mode = AgingMode::Lazy;
+    QueueBackend backend = QueueBackend::Heap;
+    bool preemptive = false;
+    int quantum = 0;
+};
+
+template <typename Policy = LinearAging>
+Schedule runScheduler(const WorkloadSpec& spec, const Setup& setup, bool tick_based = false) {
+    BasicScheduler<Policy> scheduler(setup.factor, false);
+    scheduler.setAgingMode(setup.mode);
+    scheduler.setQueueBackend(setup.backend);
+    scheduler.setPreemptive(setup.preemptive, setup.quantum);
+    scheduler.generateWorkload(spec);
+    if (tick_based) {
+        scheduler.runTickBased();
+    } else {
+        scheduler.run();
+    }
+    return scheduleOf(scheduler.getCompletedProcesses());
+}
+
+}
+
+TEST(eventEngineMatchesTickBased) {
+    for (uint64_t seed : {1, 2, 3}) {
+        for (double factor : {0.0, 0.1, 0.5}) {
+            Setup setup;
+            setup.factor = factor;
+            WorkloadSpec spec = smallWorkload(seed);
+            Schedule events = runScheduler(spec, setup);
+            CHECK_EQ(events.size(), static_cast<size_t>(spec.count));
+            CHECK_EQ(firstDifference(events, runScheduler(spec, setup, true)), -1);
+        }
+    }
+}
+
+TEST(eventEngineMatchesTickBasedPreemptive) {
+    for (int quantum : {0, 3}) {
+        Setup setup;
+        setup.preemptive = true;
+        setup.quantum = quantum;
+        WorkloadSpec spec = smallWorkload(4);
+        CHECK_EQ(firstDifference(runScheduler(spec, setup), runScheduler(spec, setup, true)), -1);
+    }
+}
+
+TEST(eventEngineMatchesTickBasedWithIo) {
+    for (bool preemptive : {false, true}) {
+        Setup setup;
+        setup.preemptive = preemptive;
+        setup.quantum = preemptive ? 4 : 0;
+        WorkloadSpec spec = smallWorkload(5, 0.5);
+        CHECK_EQ(firstDifference(runScheduler(spec, setup), runScheduler(spec, setup, true)), -1);
+    }
+}
+
+TEST(eventEngineMatchesTickBasedOtherPolicies) {
+    WorkloadSpec spec = smallWorkload(6);
+    Setup setup;
+    CHECK_EQ(firstDifference(runScheduler<StepAging<>>(spec, setup),
+                             runScheduler<StepAging<>>(spec, setup, true)), -1);
+    CHECK_EQ(firstDifference(runScheduler<FixedPointAging>(spec, setup),
+                             runScheduler<FixedPointAging>(spec, setup, true)), -1);
+}
+
+// Lazy keys and eager effective priorities round alike only when the
+// factor is binary-exact (see AgingMode)
+TEST(lazyMatchesEagerForBinaryExactFactors) {
+    for (double factor : {0.25, 0.5, 1.0}) {
+        for (bool preemptive : {false, true}) {
+            Setup lazy;
+            lazy.factor = factor;
+            lazy.preemptive = preemptive;
+            Setup eager = lazy;
+            eager.mode = AgingMode::Eager;
+            WorkloadSpec spec = smallWorkload(7);
+            CHECK_EQ(firstDifference(runScheduler(spec, lazy), runScheduler(spec, eager)), -1);
+        }
+    }
+}
+
+TEST(bucketMatchesHeapInLazyMode) {
+    for (double factor : {0.0, 0.1, 0.3}) {
+        for (bool preemptive : {false, true}) {
+            Setup heap;
+            heap.factor = factor;
+            heap.preemptive = preemptive;
+            heap.quantum = preemptive ? 2 : 0;
+            Setup bucket = heap;
+            bucket.backend = QueueBackend::Bucket;
+            WorkloadSpec spec = smallWorkload(8, 0.3);
+            CHECK_EQ(firstDifference(runScheduler(spec, heap), runScheduler(spec, bucket)), -1);
+        }
+    }
+}
+
+TEST(oneCoreMatchesScheduler) {
+    for (uint64_t seed : {9, 10}) {
+        WorkloadSpec spec = smallWorkload(seed);
+        MultiCoreScheduler multi(1, 0.1, false);
+        multi.generateWorkload(spec);
+        multi.run();
+        CHECK_EQ(firstDifference(scheduleOf(multi.getCompletedProcesses()), runScheduler(spec, Setup())), -1);
+    }
+}
+
+TEST(streamedRunMatchesTableRun) {
+    WorkloadSpec spec = smallWorkload(11, 0.2);
+    Scheduler table(0.1, false);
+    table.generateWorkload(spec);
+    table.run();
+
+    Scheduler streamed(0.1, false);
+    WorkloadGenerator generator(spec);
+    streamed.setWorkloadSource(&generator);
+    streamed.run();
+
+    Statistics a = table.getStatistics();
+    Statistics b = streamed.getStatistics();
+    CHECK_EQ(a.getCompletedProcesses(), b.getCompletedProcesses());
+    CHECK_EQ(a.getAverageWaitingTime(), b.getAverageWaitingTime());
+    CHECK_EQ(a.getTotalAgingEvents(), b.getTotalAgingEvents());
+}
+
+TEST(emptyWorkloadRunsQuietly) {
+    Scheduler scheduler(0.1, false);
+    scheduler.run();
+    CHECK_EQ(scheduler.getStatistics().getCompletedProcesses(), 0LL);
+}
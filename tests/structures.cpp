@@ -0,0 +1,196 @@
+// Data structures against simple references: the timing wheel's due order,
+// the bucket queue (far level included), fixed-point FIFO keys across a
+// sequence wrap, the latency histogram and the binary trace encoding.
+
+#include "BucketQueue.h"
+#include "LatencyHistogram.h"
+#include "PriorityQueue.h"
+#include "Test.h"
+#include "TimingWheel.h"
+#include "Trace.h"
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <utility>
+
+// Timers come out in (expiry, scheduling order) however the wheel advances
+TEST(timingWheelDueOrder) {
+    for (long long step : {1LL, 7LL, 1000LL, -1LL}) {
+        std::mt19937_64 gen(step + 100);
+        TimingWheel<int> wheel;
+        std::vector<std::pair<long long, int>> expected;
+        int next_id = 0;
+        // Spread over every level, with many equal expiries
+        for (int i = 0; i < 2000; i++) {
+            long long expiry = i % 3 == 0 ? static_cast<long long>(gen() % 50)
+                                          : static_cast<long long>(gen() % (1LL << (gen() % 40)));
+            wheel.schedule(expiry, next_id);
+            expected.push_back({expiry, next_id++});
+        }
+        std::stable_sort(expected.begin(), expected.end(),
+                         [](const std::pair<long long, int>& a, const std::pair<long long, int>& b) {
+                             return a.first < b.first;
+                         });
+
+        std::vector<std::pair<long long, int>> fired;
+        while (!wheel.empty()) {
+            // step -1: jump straight to the next expiry, as the event engine
+            // does; otherwise fixed steps, skipping long empty stretches
+            long long to = step < 0 ? wheel.nextExpiry()
+                                    : std::max(wheel.getTime() + step, wheel.nextExpiry() - step / 2);
+            wheel.advance(to);
+            while (wheel.hasDue()) {
+                long long at = wheel.dueTime();
+                fired.push_back({at, wheel.popDue()});
+            }
+        }
+        CHECK(fired == expected);
+    }
+}
+
+TEST(timingWheelPastExpiryIsDueNext) {
+    TimingWheel<int> wheel;
+    wheel.advance(100);
+    wheel.schedule(40, 1);
+    CHECK_EQ(wheel.nextExpiry(), 100LL);
+    wheel.advance(100);
+    CHECK(wheel.hasDue());
+    CHECK_EQ(wheel.popDue(), 1);
+}
+
+// Random pushes, erases and pops against an ordered set, with one level in
+// four far outside the 2^16-level window
+TEST(bucketQueueMatchesOrderedSet) {
+    std::mt19937 gen(7);
+    for (int round = 0; round < 50; round++) {
+        BucketQueue<long long, uint32_t> queue;
+        std::set<std::pair<long long, uint32_t>> reference;
+        std::vector<long long> key_of(500);
+        for (int op = 0; op < 4000; op++) {
+            uint32_t payload = gen() % 500;
+            int action = gen() % 10;
+            if (action < 3 && !reference.empty()) {
+                CHECK_EQ(queue.top().key, reference.begin()->first);
+                CHECK_EQ(queue.pop().key, reference.begin()->first);
+                reference.erase(reference.begin());
+            } else if (action < 4) {
+                if (queue.contains(payload)) {
+                    queue.erase(payload);
+                    reference.erase({key_of[payload], payload});
+                }
+            } else if (!queue.contains(payload)) {
+                int level = gen() % 4 == 0 ? static_cast<int>(gen() % 2000000000) - 1000000000
+                                           : static_cast<int>(gen() % 20);
+                long long key = (static_cast<long long>(level) * 1000 + gen() % 500) * 512 + payload;
+                queue.push(level, key, payload);
+                reference.insert({key, payload});
+                key_of[payload] = key;
+            }
+            CHECK_EQ(queue.size(), reference.size());
+        }
+        while (!reference.empty()) {
+            CHECK_EQ(queue.pop().key, reference.begin()->first);
+            reference.erase(reference.begin());
+        }
+    }
+}
+
+// A batch inserted across the 2^24 sequence wrap keeps insertion order
+// among equal keys
+TEST(fixedPointFifoAcrossSequenceWrap) {
+    BasicPriorityQueue<FixedPointAging> queue(0.1);
+    Process filler(0, 5, 0, 1);
+    for (uint64_t i = 0; i + 4 < FixedPointAging::SEQUENCE_LIMIT; i++) {
+        queue.insert(&filler);
+        queue.extractMin();
+    }
+    std::vector<Process> batch;
+    for (int id = 1; id <= 8; id++) {
+        batch.emplace_back(id, 5, 0, 1);
+    }
+    std::vector<Process*> pointers;
+    for (Process& p : batch) {
+        pointers.push_back(&p);
+    }
+    queue.insertBatch(pointers);
+    for (int id = 1; id <= 8; id++) {
+        Process* p = queue.extractMin();
+        CHECK(p != nullptr);
+        if (p) {
+            CHECK_EQ(p->getId(), id);
+        }
+    }
+    CHECK(queue.isEmpty());
+}
+
+TEST(fixedPointKeyOverflowThrows) {
+    BasicPriorityQueue<FixedPointAging> queue(1.0);
+    Process fits(1, 10, (1LL << 28) - 20, 5);
+    Process too_late(2, 10, 1LL << 28, 5);
+    queue.insert(&fits);
+    bool thrown = false;
+    try {
+        queue.insert(&too_late);
+    } catch (const std::overflow_error&) {
+        thrown = true;
+    }
+    CHECK(thrown);
+    CHECK_EQ(queue.size(), 1);
+}
+
+TEST(histogramCountAbove) {
+    LatencyHistogram histogram;
+    for (long long value : {10LL, 20LL, 300LL, 301LL, 5000LL}) {
+        histogram.record(value);
+    }
+    CHECK_EQ(histogram.countAbove(-1), 5ULL);
+    CHECK_EQ(histogram.countAbove(10), 4ULL);      // Exact below 256
+    CHECK_EQ(histogram.countAbove(299), 3ULL);
+    CHECK_EQ(histogram.countAbove(300), 3ULL);     // 300-301 share a bucket: counted whole
+    CHECK_EQ(histogram.countAbove(4999), 1ULL);
+    CHECK_EQ(histogram.countAbove(5000), 0ULL);
+}
+
+// Fields are little-endian on any host, and read back unchanged
+TEST(binaryTraceRoundTrip) {
+    std::string path = "bin/test_trace.bin";
+    std::vector<TraceRecord> records = {{1, 3, 0, 5}, {-7, 0, 99, 1}, {42, 2147483647, 1LL << 40, 2147483647}};
+    TraceWriter writer;
+    CHECK(writer.open(path));
+    for (const TraceRecord& record : records) {
+        CHECK(writer.write(record));
+    }
+    CHECK(writer.close());
+
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    unsigned char bytes[16 + 20] = {};
+    CHECK(file && std::fread(bytes, 1, sizeof(bytes), file) == sizeof(bytes));
+    if (file) {
+        std::fclose(file);
+    }
+    CHECK_EQ(static_cast<int>(bytes[8]), 3);      // Record count, low byte first
+    CHECK_EQ(static_cast<int>(bytes[15]), 0);
+    CHECK_EQ(static_cast<int>(bytes[16]), 1);     // id 1
+    CHECK_EQ(static_cast<int>(bytes[20]), 3);     // priority 3
+    CHECK_EQ(static_cast<int>(bytes[32]), 5);     // burst 5
+
+    TraceReader reader(1);
+    CHECK(reader.open(path));
+    TraceRecord record;
+    size_t read = 0;
+    while (reader.next(record)) {
+        // The reader hands records out sorted by arrival; these already are
+        if (read < records.size()) {
+            CHECK_EQ(record.id, records[read].id);
+            CHECK_EQ(record.priority, records[read].priority);
+            CHECK_EQ(record.arrival, records[read].arrival);
+            CHECK_EQ(record.burst, records[read].burst);
+        }
+        read++;
+    }
+    CHECK(!reader.failed());
+    CHECK_EQ(read, records.size());
+    std::remove(path.c_str());
+}